@@ -0,0 +1,223 @@
+
+// okayply benchmark
+// generates synthetic point clouds & meshes, writes and reads them in every format through the
+// different paths of okayply and prints MB/s, rows/s and the peak memory of each case.
+//
+// build: g++ -std=c++20 -O2 -pthread -I. benchmark.cpp -o benchmark
+// usage: benchmark [rows (default 1000000)] [schemas (default: points mesh lists wide)]
+//
+// points: fixed size rows only (x y z nx ny nz float, red green blue alpha uchar)
+// mesh:   vertex x y z float and twice as many triangles (list uchar int)
+// lists:  list heavy faces with 3 to 8 indices, 2 texture coordinates per index and flags
+// wide:   32 properties of all types in one element
+
+#include <okayply.h>
+#include <filesystem>
+#include <iostream>
+#include <chrono>
+#include <random>
+
+#if defined(_WIN32)
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+	// the layout of the points schema for the binding path
+	struct point
+	{
+		float x, y, z, nx, ny, nz;
+		std::uint8_t red, green, blue, alpha;
+	};
+
+	// peak resident memory of the process in bytes. on linux it is reset before every case,
+	// elsewhere it is the peak of the whole run so far.
+	std::size_t peakMemory()
+	{
+#if defined(_WIN32)
+		PROCESS_MEMORY_COUNTERS pmc{};
+		GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc));
+		return pmc.PeakWorkingSetSize;
+#elif defined(__linux__)
+		std::ifstream status("/proc/self/status");
+		std::string line;
+		while(std::getline(status, line))
+			if(line.starts_with("VmHWM:"))
+				return std::stoull(line.substr(6)) * 1024;
+		return 0;
+#else
+		rusage usage{};
+		getrusage(RUSAGE_SELF, &usage);
+		return static_cast<std::size_t>(usage.ru_maxrss); // bytes on macOS
+#endif
+	}
+
+	void resetPeak()
+	{
+#if defined(__linux__)
+		std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+	}
+
+	// fills a root with rows of a schema, rows is the number of vertices (faces for lists)
+	void generate(
+		okayply::root & ply,
+		std::string_view schema,
+		std::size_t rows)
+	{
+		std::mt19937 rng(1234);
+		std::uniform_real_distribution<float> real(-100.0f, 100.0f);
+		auto fill = [&rng, &real] (okayply::prop & p, std::type_index const & tid) {
+			auto random = [&] (auto* x) {
+				using T = std::remove_pointer_t<decltype(x)>;
+				for(auto & v : p.get<T>())
+					v = static_cast<T>(std::is_floating_point_v<T> ? real(rng) : static_cast<float>(rng() % 128));
+			};
+			if(tid == typeid(float)) random((float*)nullptr);
+			else if(tid == typeid(double)) random((double*)nullptr);
+			else if(tid == typeid(std::int8_t)) random((std::int8_t*)nullptr);
+			else if(tid == typeid(std::uint8_t)) random((std::uint8_t*)nullptr);
+			else if(tid == typeid(std::int16_t)) random((std::int16_t*)nullptr);
+			else if(tid == typeid(std::uint16_t)) random((std::uint16_t*)nullptr);
+			else if(tid == typeid(std::int32_t)) random((std::int32_t*)nullptr);
+			else if(tid == typeid(std::uint32_t)) random((std::uint32_t*)nullptr);
+		};
+		if(schema == "points")
+		{
+			auto & v = ply("vertex", rows);
+			for(auto n : {"x", "y", "z", "nx", "ny", "nz"})
+				fill(v(n, typeid(float)), typeid(float));
+			for(auto n : {"red", "green", "blue", "alpha"})
+				fill(v(n, typeid(std::uint8_t)), typeid(std::uint8_t));
+		}
+		else if(schema == "mesh")
+		{
+			auto & v = ply("vertex", rows);
+			for(auto n : {"x", "y", "z"})
+				fill(v(n, typeid(float)), typeid(float));
+			auto & f = ply("face", rows * 2);
+			for(auto & tri : f("vertex_indices").get<std::vector<int>>())
+				tri = {int(rng() % rows), int(rng() % rows), int(rng() % rows)};
+		}
+		else if(schema == "lists")
+		{
+			auto & f = ply("face", rows);
+			auto vi = f("vertex_indices").get<std::vector<int>>();
+			auto tc = f("texcoord").get<std::vector<float>>();
+			for(std::size_t i = 0; i < rows; i++)
+			{
+				vi[i].resize(3 + rng() % 6);
+				for(auto & x : vi[i])
+					x = int(rng() % 1000000);
+				tc[i].resize(vi[i].size() * 2);
+				for(auto & x : tc[i])
+					x = real(rng);
+			}
+			fill(f("flags", typeid(std::uint8_t)), typeid(std::uint8_t));
+		}
+		else if(schema == "wide")
+		{
+			std::type_index const tids[] = {
+				typeid(float), typeid(double), typeid(std::int8_t), typeid(std::uint8_t),
+				typeid(std::int16_t), typeid(std::uint16_t), typeid(std::int32_t), typeid(std::uint32_t)};
+			auto & e = ply("sample", rows);
+			for(std::size_t i = 0; i < 32; i++)
+				fill(e(std::format("p{}", i), tids[i % 8]), tids[i % 8]);
+		}
+		else
+			throw std::runtime_error(std::format("unknown schema \"{}\"", schema));
+	}
+
+	// best time of a few runs in seconds and the peak memory of the case
+	template<typename F>
+	std::pair<double, std::size_t> measure(F && f)
+	{
+		resetPeak();
+		double best = 1e30;
+		for(int i = 0; i < 3; i++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			f();
+			best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		}
+		return {best, peakMemory()};
+	}
+
+	void report(
+		std::string_view schema,
+		std::string_view fmt,
+		std::string_view path,
+		std::size_t bytes,
+		std::size_t rows,
+		std::pair<double, std::size_t> result)
+	{
+		auto [seconds, peak] = result;
+		std::cout << std::format("{:<8}{:<22}{:<14}{:>10.1f}{:>12.1f}{:>12.2f}{:>12.1f}\n",
+			schema, fmt, path, bytes / 1e6, bytes / 1e6 / seconds, rows / 1e6 / seconds, peak / 1e6);
+	}
+
+	template<okayply::format ff, std::endian ee>
+	void run(
+		std::string_view schema,
+		std::string_view fmt,
+		okayply::root & ply,
+		std::size_t rows)
+	{
+		auto path = (std::filesystem::temp_directory_path() / std::format("okayply_benchmark_{}_{}.ply", schema, fmt)).string();
+		auto write = measure([&] { ply.write<ff, ee>(path); });
+		auto bytes = static_cast<std::size_t>(std::filesystem::file_size(path));
+		report(schema, fmt, "write", bytes, rows, write);
+
+		report(schema, fmt, "read", bytes, rows, measure([&] { okayply::root r; r.read(path); }));
+		report(schema, fmt, "read threads", bytes, rows, measure([&] { okayply::root r; r.threads(0); r.read(path); }));
+		if(schema == "mesh" || schema == "lists")
+			report(schema, fmt, "read flat", bytes, rows, measure([&] { okayply::root r; r.flatLists(true); r.read(path); }));
+		if constexpr(ff == okayply::format::binary)
+			report(schema, fmt, "map", bytes, rows, measure([&] { okayply::root r; r.map(path); }));
+		report(schema, fmt, "reader", bytes, rows, measure([&] {
+			okayply::reader r(path);
+			while(r.next(std::size_t(1) << 16));
+		}));
+		if(schema == "points")
+			report(schema, fmt, "binding", bytes, rows, measure([&] {
+				std::vector<point> points;
+				okayply::binding<point> b("vertex", points);
+				b.bind("x", &point::x).bind("y", &point::y).bind("z", &point::z)
+					.bind("nx", &point::nx).bind("ny", &point::ny).bind("nz", &point::nz)
+					.bind("red", &point::red).bind("green", &point::green).bind("blue", &point::blue).bind("alpha", &point::alpha);
+				okayply::typed::read(path, b);
+			}));
+		std::filesystem::remove(path);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	try {
+		std::size_t rows = argc > 1 ? std::stoull(argv[1]) : 1000000;
+		std::vector<std::string> schemas;
+		for(int i = 2; i < argc; i++)
+			schemas.emplace_back(argv[i]);
+		if(schemas.empty())
+			schemas = {"points", "mesh", "lists", "wide"};
+
+		std::cout << std::format("{:<8}{:<22}{:<14}{:>10}{:>12}{:>12}{:>12}\n", "schema", "format", "path", "MB", "MB/s", "Mrows/s", "peak MB");
+		for(auto & schema : schemas)
+		{
+			okayply::root ply;
+			generate(ply, schema, rows);
+			std::size_t total = 0; // rows of all elements
+			for(auto & e : ply.elements())
+				total += e.get().size();
+			run<okayply::format::ascii, std::endian::native>(schema, okayply::str::ascii, ply, total);
+			run<okayply::format::binary, std::endian::little>(schema, okayply::str::binary_little_endian, ply, total);
+			run<okayply::format::binary, std::endian::big>(schema, okayply::str::binary_big_endian, ply, total);
+		}
+	}
+	catch (std::exception& e) {
+		std::cout << e.what();
+	}
+	return EXIT_SUCCESS;
+}
@@ -12,16 +12,57 @@
 
 #include <unordered_map>
 #include <string_view>
+#include <system_error>
 #include <functional>
+#include <condition_variable>
+#include <chrono>
+#include <exception>
 #include <typeindex>
 #include <fstream>
 #include <sstream>
+#include <cstring>
+#include <charconv>
+#include <format>
+#include <memory>
 #include <vector>
+#include <deque>
+#include <limits>
 #include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
 #include <array>
 #include <span>
+#include <bit>
 #include <any>
 
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// byte swaps use SSSE3 / AVX2 shuffles, picked at runtime with gcc / clang on x86 and at
+// compile time elsewhere (e.g. /arch:AVX2)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define OKAYPLY_SIMD_TARGET(x) __attribute__((target(x)))
+#define OKAYPLY_SIMD_DISPATCH
+#elif defined(__AVX2__) || defined(__SSSE3__)
+#define OKAYPLY_SIMD_TARGET(x)
+#endif
+#if defined(OKAYPLY_SIMD_TARGET)
+#include <immintrin.h>
+#endif
+
 #define USE_CRLF_LFCR_HEADER_HACK
 
 namespace okayply
@@ -34,7 +75,11 @@ namespace okayply
 	struct prop;
 	struct elem;
 	struct root;
+	struct reader;
+	struct writer;
+	struct typed;
 	struct type;
+	template<typename T> struct flatlist;
 
 	namespace str
 	{
@@ -68,13 +113,14 @@ namespace okayply
 		inline constexpr auto binary_little_endian = "binary_little_endian";
 		inline constexpr auto binary_big_endian = "binary_big_endian";
 		inline constexpr auto version = "1.0";
+		inline constexpr auto step = "step"; // first word of a rowindex file
 		inline constexpr auto cr = '\r'; // definition says: use \r but most implementations use \n
 		inline constexpr auto lf = '\n'; // definition says: use \r but most implementations use \n
 		inline constexpr auto space = ' ';
 		inline constexpr auto invalidSymbols = "\n\v\f\r"; // do not use these in comments or names
 		inline constexpr auto ignoreLineSymbols = "{#;~([|"; // everything in a line after these symbols will be ignored when reading the header or ascii
-		inline constexpr auto f32fmt = "{:.9}";
-		inline constexpr auto f64fmt = "{:.17}";
+		inline constexpr auto f32digits = 9; // significant digits of floats in ascii files
+		inline constexpr auto f64digits = 17; // significant digits of doubles in ascii files
 	}
 
 	namespace internal
@@ -106,6 +152,17 @@ namespace okayply
             std::conditional_t<i == 2, std::uint16_t,
             std::conditional_t<i == 4, std::uint32_t,
             std::uint64_t>>>;
+
+		// row layout of a flatlist<T>, independent of T
+		struct flatrows
+		{
+			std::vector<std::size_t> offsets; // number of rows + 1, starts with 0, empty if arity != 0
+			std::size_t              arity = 0; // != 0: every row has arity values
+
+			std::size_t first(std::size_t i) const { return arity ? i * arity : offsets[i]; }
+			std::size_t count(std::size_t i) const { return arity ? arity : offsets[i + 1] - offsets[i]; }
+		};
+
 		struct ErasedInfoBase
 		{
 			virtual bool            isList() const = 0;
@@ -120,6 +177,18 @@ namespace okayply
             virtual void*           rawPtr(std::any& any) const = 0; // pointer to element [0] of vector<T>
 			virtual const void*     rawPtr(std::any const & any) const = 0; // pointer to element [0] of vector<T>
 
+            // flat property lists (see flatlist<T>)
+			virtual std::any        flat(std::size_t size) const = 0; // flatlist<T> with size empty rows
+			virtual flatrows*       rows(std::any& any) const = 0; // nullptr if any is no flatlist<T>
+			virtual const flatrows* rows(std::any const & any) const = 0; // nullptr if any is no flatlist<T>
+			virtual void*           values(std::any& any) const = 0; // pointer to vector<T> of a flatlist<T>
+			virtual const void*     values(std::any const & any) const = 0; // pointer to vector<T> of a flatlist<T>
+			virtual char*           resize(std::any& any, std::size_t n) const = 0; // resizes vector<T> of a flatlist<T>, returns element [0]
+			virtual void            check(std::any const & any, std::size_t size) const = 0; // throws if a flatlist<T> does not have size valid rows
+			virtual void            splice(std::any& any, std::size_t at, std::any const & src) const = 0; // copies the values of flatlist<T> src to values[at...]
+			virtual void            reshape(std::any& any, std::size_t size) const = 0; // size rows (empty for flatlist<T>), keeps the capacity
+			virtual std::size_t     bytes(std::any const & any) const = 0; // allocated bytes of vector<T>, vector<vector<T>> or flatlist<T>
+
 			virtual ~ErasedInfoBase() = default;
 		};
 
@@ -147,15 +216,24 @@ namespace okayply
 			{
 				if constexpr(is_list)
 				{
-					auto const & vv = std::any_cast<std::vector<std::vector<T>>const &>(any);
 					std::size_t max = 0;
-					for(auto & v : vv)
-						max = std::max(max, v.size());
+					if(auto f = std::any_cast<flatlist<T>>(&any))
+					{
+						max = f->arity;
+						for(std::size_t i = 0; i + 1 < f->offsets.size(); i++)
+							max = std::max(max, f->offsets[i + 1] - f->offsets[i]);
+					}
+					else
+					{
+						auto const & vv = std::any_cast<std::vector<std::vector<T>>const &>(any);
+						for(auto & v : vv)
+							max = std::max(max, v.size());
+					}
 					return max < 256
                         ? 1
                         : max < 65536
                             ? 2
-                            : 3;
+                            : 4;
 				}
 				else if constexpr(!is_list)
 				{
@@ -186,7 +264,11 @@ namespace okayply
                 std::any& any) const override
 			{
 				if constexpr(is_list)
+				{
+					if(auto f = std::any_cast<flatlist<T>>(&any))
+						return reinterpret_cast<void*>(f->values.data());
                     return reinterpret_cast<void*>(std::any_cast<std::vector<std::vector<T>>&>(any).data());
+				}
 				else
                     return reinterpret_cast<void*>(std::any_cast<std::vector<T>&>(any).data());
 			}
@@ -194,11 +276,170 @@ namespace okayply
                 const std::any& any) const override
 			{
 				if constexpr(is_list)
+				{
+					if(auto f = std::any_cast<flatlist<T>>(&any))
+						return reinterpret_cast<const void*>(f->values.data());
                     return reinterpret_cast<const void*>(std::any_cast<std::vector<std::vector<T>>const &>(any).data());
+				}
 				else
                     return reinterpret_cast<const void*>(std::any_cast<std::vector<T>const &>(any).data());
 			}
+			std::any flat(
+                std::size_t size) const override
+			{
+				flatlist<T> f;
+				f.offsets.resize(size + 1);
+				return f;
+			}
+			flatrows* rows(
+                std::any& any) const override
+			{
+				return std::any_cast<flatlist<T>>(&any);
+			}
+			const flatrows* rows(
+                std::any const & any) const override
+			{
+				return std::any_cast<flatlist<T>>(&any);
+			}
+			void* values(
+                std::any& any) const override
+			{
+				return &std::any_cast<flatlist<T>&>(any).values;
+			}
+			const void* values(
+                std::any const & any) const override
+			{
+				return &std::any_cast<flatlist<T> const &>(any).values;
+			}
+			char* resize(
+                std::any& any,
+                std::size_t n) const override
+			{
+				auto & v = std::any_cast<flatlist<T>&>(any).values;
+				v.resize(n);
+				return reinterpret_cast<char*>(v.data());
+			}
+			void check(
+                std::any const & any,
+                std::size_t size) const override
+			{
+				auto f = std::any_cast<flatlist<T>>(&any);
+				if(!f)
+					return;
+				bool valid = f->arity
+                    ? f->offsets.empty() && f->values.size() == size * f->arity
+                    : f->offsets.size() == size + 1 && f->offsets[0] == 0 && f->offsets[size] == f->values.size();
+				for(std::size_t i = 0; valid && !f->arity && i < size; i++)
+					valid = f->offsets[i] <= f->offsets[i + 1];
+				if(!valid)
+					throw std::runtime_error("flat property list has invalid offsets");
+			}
+			void splice(
+                std::any& any,
+                std::size_t at,
+                std::any const & src) const override
+			{
+				auto & s = std::any_cast<flatlist<T> const &>(src).values;
+				std::copy(s.begin(), s.end(), std::any_cast<flatlist<T>&>(any).values.begin() + at);
+			}
+			void reshape(
+                std::any& any,
+                std::size_t size) const override
+			{
+				if constexpr(is_list)
+				{
+					if(auto f = std::any_cast<flatlist<T>>(&any))
+					{
+						f->offsets.assign(size + 1, 0);
+						f->arity = 0;
+					}
+					else
+						std::any_cast<std::vector<std::vector<T>>&>(any).resize(size);
+				}
+				else
+					std::any_cast<std::vector<T>&>(any).resize(size);
+			}
+			std::size_t bytes(
+                std::any const & any) const override
+			{
+				if constexpr(is_list)
+				{
+					if(auto f = std::any_cast<flatlist<T>>(&any))
+						return f->values.capacity() * sizeof(T) + f->offsets.capacity() * sizeof(std::size_t);
+					auto & vv = std::any_cast<std::vector<std::vector<T>> const &>(any);
+					auto n = vv.capacity() * sizeof(std::vector<T>);
+					for(auto & v : vv)
+						n += v.capacity() * sizeof(T);
+					return n;
+				}
+				else
+					return std::any_cast<std::vector<T> const &>(any).capacity() * sizeof(T);
+			}
+		};
+
+		// fills a flatlist<T> row by row without knowing the number of values up front
+		struct flatfill
+		{
+			ErasedInfoBase const * info = nullptr;
+			std::any*              data = nullptr;
+			flatrows*              rows = nullptr;
+			char*                  values = nullptr;
+			std::size_t            capacity = 0;
+
+			// switches from arity to offsets for the rows after the first n
+			void unfix(std::size_t n, std::size_t size)
+			{
+				if(!rows->arity)
+					return;
+				rows->offsets.resize(size + 1);
+				for(std::size_t i = 0; i <= n; i++)
+					rows->offsets[i] = i * rows->arity;
+				rows->arity = 0;
+				values = info->resize(*data, rows->offsets[n]);
+				capacity = rows->offsets[n];
+			}
+			// room for n values in row i (rows are filled in order), returns the first one
+			char* next(std::size_t i, std::size_t n)
+			{
+				auto used = rows->offsets[i];
+				if(used + n > capacity)
+				{
+					capacity = std::max(used + n, capacity * 2);
+					values = info->resize(*data, capacity);
+				}
+				rows->offsets[i + 1] = used + n;
+				return values + used * info->typeSize();
+			}
+			// drops the capacity that was not used, uses arity if all rows have the same size
+			void finish(std::size_t size)
+			{
+				if(rows->arity)
+					return;
+				values = info->resize(*data, rows->offsets[size]);
+				auto arity = size ? rows->offsets[1] : 0;
+				for(std::size_t i = 1; arity && i < size; i++)
+					if(rows->offsets[i + 1] - rows->offsets[i] != arity)
+						arity = 0;
+				if(arity)
+				{
+					rows->offsets.clear();
+					rows->arity = arity;
+				}
+			}
 		};
+
+		template<typename T> struct isVector : std::false_type {};
+		template<typename T> struct isVector<std::vector<T>> : std::true_type {};
+
+		// the plain number types of ply files
+		template<typename T> inline constexpr bool isNumber =
+			std::is_same_v<T, std::int8_t> || std::is_same_v<T, std::uint8_t> ||
+			std::is_same_v<T, std::int16_t> || std::is_same_v<T, std::uint16_t> ||
+			std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::uint32_t> ||
+			std::is_same_v<T, float> || std::is_same_v<T, double>;
+		// a ply number type or a list of one
+		template<typename T> struct isPlyType : std::bool_constant<isNumber<T>> {};
+		template<typename T> struct isPlyType<std::vector<T>> : std::bool_constant<isNumber<T>> {};
 		inline std::uint32_t getline(
             std::istream& in,
             std::string& line,
@@ -251,770 +492,4698 @@ namespace okayply
 				r.push_back(token);
 			return r;
 		}
-	}
 
-	// Custom data types can be registered via
-	// template<typename T, bool isList> struct CustomIO : public IO
-	// and registerType<type, CustomIO>();
-	// see IO_X later in the code.
-	struct type
-	{
-		// Serialize & Deserialize
-		virtual void ascI(
-            std::istream&,
-            void*,
-            std::size_t) const = 0;
-		virtual void ascO(
-            std::ostream&,
-            const void*,
-            std::size_t) const = 0;
-		virtual void binI(
-            std::istream&,
-            void*,
-            std::size_t,
-            std::uint8_t,
-            bool) const = 0;
-		virtual void binO(
-            std::ostream&,
-            const void*,
-            std::size_t,
-            std::uint8_t,
-            bool) const = 0;
+		// read only memory mapping of a whole file
+		struct filemap
+		{
+			explicit filemap(
+                const std::string& path)
+			{
+#if defined(_WIN32)
+				file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+				LARGE_INTEGER size;
+				if(file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_, &size))
+				{
+					if(file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+					throw std::runtime_error(std::format("cannot open file in read mode: \"{}\"", path));
+				}
+				size_ = static_cast<std::size_t>(size.QuadPart);
+				if(size_)
+				{
+					mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+					if(mapping_)
+						data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+					if(!data_)
+					{
+						if(mapping_) CloseHandle(mapping_);
+						CloseHandle(file_);
+						throw std::runtime_error(std::format("cannot map file: \"{}\"", path));
+					}
+				}
+#else
+				fd_ = ::open(path.c_str(), O_RDONLY);
+				struct stat st;
+				if(fd_ < 0 || ::fstat(fd_, &st) != 0)
+				{
+					if(fd_ >= 0) ::close(fd_);
+					throw std::runtime_error(std::format("cannot open file in read mode: \"{}\"", path));
+				}
+				size_ = static_cast<std::size_t>(st.st_size);
+				if(size_)
+				{
+					auto p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+					if(p == MAP_FAILED)
+					{
+						::close(fd_);
+						throw std::runtime_error(std::format("cannot map file: \"{}\"", path));
+					}
+					data_ = static_cast<const char*>(p);
+				}
+#endif
+			}
+			~filemap()
+			{
+#if defined(_WIN32)
+				if(data_) UnmapViewOfFile(data_);
+				if(mapping_) CloseHandle(mapping_);
+				if(file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+				if(data_) ::munmap(const_cast<char*>(data_), size_);
+				if(fd_ >= 0) ::close(fd_);
+#endif
+			}
+			filemap(filemap const &) = delete;
+			filemap& operator=(filemap const &) = delete;
 
-		// First name will be used when writing, all names are valid for reading
-		virtual std::vector<std::string_view> names() const = 0;
+			const char* data() const { return data_; }
+			std::size_t size() const { return size_; }
 
-		// Do not touch
-		virtual ~type() = default;
-	};
+		private:
+			const char* data_ = nullptr;
+			std::size_t size_ = 0;
+#if defined(_WIN32)
+			HANDLE file_ = INVALID_HANDLE_VALUE;
+			HANDLE mapping_ = nullptr;
+#else
+			int fd_ = -1;
+#endif
+		};
 
-	struct prop
-	{
-		friend root; // friends are nice.
-		friend elem;
+		// std::streambuf that either reads large blocks from another streambuf
+		// or sits on top of a memory block (no copies involved). need() gives
+		// direct access to the next n bytes for block decoding. sources that cannot
+		// seek (pipes, sockets) are only read as far as needed, the others ahead and
+		// unread() gives the bytes that were not consumed back.
+		struct inbuf : public std::streambuf
+		{
+			explicit inbuf(
+                std::streambuf* src,
+                std::size_t capacity = std::size_t(1) << 20) : src_(src), buf_(capacity)
+			{
+				setg(buf_.data(), buf_.data(), buf_.data());
+				exact_ = src->pubseekoff(0, std::ios::cur, std::ios::in) == std::streampos(-1);
+			}
+			inbuf(
+                const char* data,
+                std::size_t size)
+			{
+				assign(data, size);
+			}
+			// reads from another memory block
+			void assign(
+                const char* data,
+                std::size_t size)
+			{
+				auto p = const_cast<char*>(data);
+				setg(p, p, p + size);
+			}
 
-        // how many datapoints are in the property?
-		std::size_t size() const;
+			// pointer to at least n available bytes, nullptr if the data ends before
+			const char* need(std::size_t n)
+			{
+				auto avail = static_cast<std::size_t>(egptr() - gptr());
+				if(avail >= n)
+					return gptr();
+				if(!src_)
+					return nullptr;
+				if(buf_.size() < n)
+				{
+					std::vector<char> bigger(n);
+					std::memcpy(bigger.data(), gptr(), avail);
+					consumed_ += static_cast<std::size_t>(gptr() - eback());
+					buf_.swap(bigger);
+				}
+				else
+				{
+					std::memmove(buf_.data(), gptr(), avail);
+					consumed_ += static_cast<std::size_t>(gptr() - eback());
+				}
+				while(avail < n)
+				{ // sgetn may return less than requested on pipes
+					auto want = exact_ ? n - avail : buf_.size() - avail;
+					auto got = src_->sgetn(buf_.data() + avail, static_cast<std::streamsize>(want));
+					if(got <= 0) break;
+					avail += static_cast<std::size_t>(got);
+				}
+				setg(buf_.data(), buf_.data(), buf_.data() + avail);
+				return avail >= n ? gptr() : nullptr;
+			}
+			// seeks the source back by the bytes that were read but not consumed, so it ends
+			// after the consumed ones
+			void unread()
+			{
+				if(!src_ || exact_ || !available())
+					return;
+				if(src_->pubseekoff(-static_cast<std::streamoff>(available()), std::ios::cur, std::ios::in) != std::streampos(-1))
+					skip(available());
+			}
+			// makes at least n bytes available (less at the end of the data) and returns how many
+			// of the available bytes are complete lines (all of them at the end of the data)
+			std::size_t lines(std::size_t n)
+			{
+				if(!need(n))
+					return available();
+				auto last = egptr();
+				while(last != gptr() && last[-1] != str::lf && last[-1] != str::cr)
+					last--;
+				return static_cast<std::size_t>(last - gptr());
+			}
+			// true if the source cannot seek back, bytes must not be read past the data
+			bool exact() const
+			{
+				return exact_;
+			}
+			// number of bytes that can be consumed without reading
+			std::size_t available() const
+			{
+				return static_cast<std::size_t>(egptr() - gptr());
+			}
+			// available bytes are [first(), last())
+			const char* first() const
+			{
+				return gptr();
+			}
+			const char* last() const
+			{
+				return egptr();
+			}
+			// consume n bytes that are available (see need())
+			void skip(std::size_t n)
+			{
+				setg(eback(), gptr() + n, egptr());
+			}
+			// number of bytes consumed so far (the offset when reading from memory)
+			std::size_t pos() const
+			{
+				return consumed_ + static_cast<std::size_t>(gptr() - eback());
+			}
+			// jump to an offset, only when reading from memory
+			void pos(std::size_t p)
+			{
+				setg(eback(), eback() + p, egptr());
+			}
 
-        // whats my name?
-		std::string_view name() const;
+		protected:
+			int_type underflow() override
+			{
+				if(gptr() == egptr() && !need(1))
+					return traits_type::eof();
+				return traits_type::to_int_type(*gptr());
+			}
 
-        // mutable data access
-		template<typename T> std::span<T> get();
+		private:
+			std::streambuf*   src_ = nullptr;
+			std::vector<char> buf_;
+			std::size_t       consumed_ = 0;
+			bool              exact_ = false; // the source cannot seek back
+		};
 
-        // set data
-		template<typename T> void set(std::span<T const>);
-		template<typename T> void set(std::vector<T> const &);
+		// reads another streambuf block by block on a second thread while the blocks before are
+		// consumed, so waiting for the source and decoding overlap. the thread starts with the
+		// first read and reads at most blocks blocks ahead.
+		struct prefetchbuf : public std::streambuf
+		{
+			explicit prefetchbuf(
+                std::streambuf* src,
+                std::size_t blockSize = std::size_t(1) << 20,
+                std::size_t blocks = 3) : src_(src), blocks_(blocks, std::vector<char>(blockSize)), sizes_(blocks)
+			{
+				setg(nullptr, nullptr, nullptr);
+			}
+			~prefetchbuf()
+			{
+				{
+					std::lock_guard lock(mutex_);
+					stop_ = true;
+				}
+				cv_.notify_all();
+				if(thread_.joinable())
+					thread_.join();
+			}
 
-        // gets the type of the property
-		std::type_index type() const;
+		protected:
+			int_type underflow() override
+			{
+				if(gptr() != egptr())
+					return traits_type::to_int_type(*gptr());
+				if(!thread_.joinable())
+					thread_ = std::thread([this] () { fill(); });
+				std::unique_lock lock(mutex_);
+				if(eback())
+				{ // the consumed block can be filled again
+					head_ = (head_ + 1) % blocks_.size();
+					ready_--;
+					cv_.notify_all();
+				}
+				cv_.wait(lock, [this] () { return ready_ || end_; });
+				if(!ready_)
+				{
+					setg(nullptr, nullptr, nullptr);
+					if(error_)
+						std::rethrow_exception(error_);
+					return traits_type::eof();
+				}
+				auto p = blocks_[head_].data();
+				setg(p, p, p + sizes_[head_]);
+				return traits_type::to_int_type(*gptr());
+			}
 
-        // for lists, this is std::vector<type>, for non lists, this is equal to type()
-		std::type_index listType() const;
+		private:
+			void fill()
+			{
+				for(std::size_t tail = 0;; tail = (tail + 1) % blocks_.size())
+				{
+					{
+						std::unique_lock lock(mutex_);
+						cv_.wait(lock, [this] () { return ready_ < blocks_.size() || stop_; });
+						if(stop_)
+							return;
+					}
+					// the block at tail is neither ready nor consumed
+					auto & block = blocks_[tail];
+					std::size_t n = 0;
+					try
+					{
+						while(n < block.size())
+						{ // sgetn may return less than requested on pipes
+							auto got = src_->sgetn(block.data() + n, static_cast<std::streamsize>(block.size() - n));
+							if(got <= 0) break;
+							n += static_cast<std::size_t>(got);
+						}
+					}
+					catch(...)
+					{
+						std::lock_guard lock(mutex_);
+						error_ = std::current_exception();
+					}
+					std::lock_guard lock(mutex_);
+					sizes_[tail] = n;
+					if(n)
+						ready_++;
+					end_ = n < block.size();
+					cv_.notify_all();
+					if(end_)
+						return;
+				}
+			}
 
-         // is true if the property is a property list
-		bool isList() const;
+			std::streambuf*                src_;
+			std::vector<std::vector<char>> blocks_;
+			std::vector<std::size_t>       sizes_; // of the data in each block
+			std::size_t                    head_ = 0; // block that is consumed
+			std::size_t                    ready_ = 0; // number of filled blocks from head_ on
+			bool                           end_ = false; // no more blocks after the ready ones
+			bool                           stop_ = false;
+			std::exception_ptr             error_;
+			std::mutex                     mutex_;
+			std::condition_variable        cv_;
+			std::thread                    thread_;
+		};
 
-        // start adress of data
-		void* rawPtr();
+		// runs work(0) ... work(count - 1) on up to threads threads, stops at the first exception
+		// and rethrows it
+		template<typename F>
+		inline void parallel(
+            unsigned threads,
+            std::size_t count,
+            F && work)
+		{
+			std::atomic<std::size_t> next = 0;
+			std::atomic<bool> failed = false;
+			std::exception_ptr error;
+			auto run = [&] () {
+				for(std::size_t t; !failed && (t = next++) < count;)
+				{
+					try
+					{
+						work(t);
+					}
+					catch(...)
+					{
+						if(!failed.exchange(true))
+							error = std::current_exception();
+					}
+				}
+			};
+			std::vector<std::thread> pool;
+			for(unsigned i = 1; i < std::min<std::size_t>(threads, count); i++)
+				pool.emplace_back(run);
+			run();
+			for(auto & t : pool)
+				t.join();
+			if(error)
+				std::rethrow_exception(error);
+		}
 
-        // data size in bytes
-		std::size_t rawSize();
+		// bytes read from / written to a stream so far (for instrumentation), 0 if unknown
+		inline std::size_t position(
+            std::istream& in)
+		{
+			if(auto buf = dynamic_cast<inbuf*>(in.rdbuf()))
+				return buf->pos();
+			auto p = in.tellg();
+			return p == std::streampos(-1) ? 0 : static_cast<std::size_t>(p);
+		}
+		inline std::size_t position(
+            std::ostream& out)
+		{
+			auto p = out.tellp();
+			return p == std::streampos(-1) ? 0 : static_cast<std::size_t>(p);
+		}
 
-	private:
-		std::any        data_;
-		elem*           parent_ = nullptr;
-		std::type_index tid_ = typeid(void);
-		std::uint8_t    listIndexSize_ = 0; // only used when reading files
-	};
+		// can be replaced by std::byteswap(x) if everyone _HAS_CXX23
+		template<std::integral T> inline constexpr T byteswap(T x)
+		{
+			if constexpr(sizeof(T) == 1)
+				return x;
+			else if constexpr(sizeof(T) == 2)
+				return static_cast<T>((x << 8) | (x >> 8));
+			else if constexpr(sizeof(T) == 4)
+				return static_cast<T>((x << 24) | ((x << 8) & 0x00FF0000) | ((x >> 8) & 0x0000FF00) | (x >> 24));
+			else if constexpr(sizeof(T) == 8)
+				return static_cast<T>((x << 56) | ((x << 40) & 0x00FF000000000000) | ((x << 24) & 0x0000FF0000000000) | ((x << 8) & 0x000000FF00000000) | ((x >> 8) & 0x00000000FF000000) | ((x >> 24) & 0x0000000000FF0000) | ((x >> 40) & 0x000000000000FF00) | (x >> 56));
+		}
 
-	struct elem
-	{
-		friend root;
-		friend prop;
+#if defined(OKAYPLY_SIMD_TARGET)
+		// shuffle mask that reverses every N bytes of 32
+		template<std::size_t N>
+		inline constexpr auto swapOrder = [] () {
+			std::array<char, 32> o{};
+			for(std::size_t j = 0; j < o.size(); j++)
+				o[j] = static_cast<char>(j - j % N + N - 1 - j % N);
+			return o;
+		}();
 
-        // access only, returns element that matches the earliest name in the list
-		prop& operator()(
-            std::span<const std::string_view>);
-		// full initialisation
-        prop& operator()(
-            std::string_view,
-            const std::type_index&);
-        // partial initialisation (full after first Property.get<T>())
-		prop& operator()(
-            std::string_view);
-        
-        // check if property exists
-		bool has(std::string_view) const;
-        
-        // get the number of elements
+		// byte swaps the leading values of n that fill whole registers, returns how many
+		template<std::size_t N>
+		OKAYPLY_SIMD_TARGET("avx2") std::size_t byteswapAvx2(
+            char* data,
+            std::size_t n)
+		{
+			auto const mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(swapOrder<N>.data()));
+			std::size_t i = 0;
+			for(; i + 32 / N <= n; i += 32 / N)
+			{
+				auto p = reinterpret_cast<__m256i*>(data + i * N);
+				_mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask));
+			}
+			return i;
+		}
+
+		template<std::size_t N>
+		OKAYPLY_SIMD_TARGET("ssse3") std::size_t byteswapSsse3(
+            char* data,
+            std::size_t n)
+		{
+			auto const mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(swapOrder<N>.data()));
+			std::size_t i = 0;
+			for(; i + 16 / N <= n; i += 16 / N)
+			{
+				auto p = reinterpret_cast<__m128i*>(data + i * N);
+				_mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+			}
+			return i;
+		}
+#endif
+
+#if defined(OKAYPLY_SIMD_DISPATCH)
+		// 2: the cpu has AVX2, 1: SSSE3, 0: neither
+		inline int simdLevel()
+		{
+			static const int level = [] () {
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("avx2") ? 2 : __builtin_cpu_supports("ssse3") ? 1 : 0;
+			}();
+			return level;
+		}
+#endif
+
+		// reverses the bytes of n consecutive values of size N in place, with SSSE3 / AVX2 shuffles if available
+		template<std::size_t N>
+		inline void byteswapBlock(
+            char* data,
+            std::size_t n)
+		{
+			std::size_t i = 0;
+			if constexpr(N > 1)
+			{
+#if defined(__AVX2__)
+				i = byteswapAvx2<N>(data, n);
+#elif defined(OKAYPLY_SIMD_DISPATCH)
+				auto level = simdLevel();
+				i = level == 2 ? byteswapAvx2<N>(data, n) : level == 1 ? byteswapSsse3<N>(data, n) : 0;
+#elif defined(__SSSE3__)
+				i = byteswapSsse3<N>(data, n);
+#endif
+				for(; i < n; i++)
+				{
+					uintX<N> x;
+					std::memcpy(&x, data + i * N, N);
+					x = byteswap(x);
+					std::memcpy(data + i * N, &x, N);
+				}
+			}
+		}
+
+		// copies n values of size N from src to dst, consecutive values are srcStride / dstStride bytes apart
+		template<std::size_t N, bool swapEndian>
+		inline void copy(
+            const char* src,
+            std::size_t srcStride,
+            char* dst,
+            std::size_t dstStride,
+            std::size_t n)
+		{
+			if constexpr(swapEndian)
+			{ // contiguous values are swapped in bulk
+				if(dstStride == N)
+				{
+					copy<N, false>(src, srcStride, dst, dstStride, n);
+					byteswapBlock<N>(dst, n);
+					return;
+				}
+				if(srcStride == N)
+				{
+					char tmp[4096];
+					constexpr std::size_t chunk = sizeof(tmp) / N;
+					for(std::size_t i = 0; i < n; i += chunk)
+					{
+						auto m = std::min(chunk, n - i);
+						std::memcpy(tmp, src + i * N, m * N);
+						byteswapBlock<N>(tmp, m);
+						copy<N, false>(tmp, N, dst + i * dstStride, dstStride, m);
+					}
+					return;
+				}
+			}
+			for(std::size_t i = 0; i < n; i++)
+			{
+				uintX<N> x;
+				std::memcpy(&x, src + i * srcStride, N);
+				if constexpr(swapEndian)
+					x = byteswap(x);
+				std::memcpy(dst + i * dstStride, &x, N);
+			}
+		}
+
+		// copies n values of a given size from src to dst, used to (de)interleave rows and columns
+		inline void stridedCopy(
+            const char* src,
+            std::size_t srcStride,
+            char* dst,
+            std::size_t dstStride,
+            std::size_t n,
+            std::size_t size,
+            bool swapEndian)
+		{
+			switch(size)
+			{
+			case 1: copy<1, false>(src, srcStride, dst, dstStride, n); break;
+			case 2: swapEndian ? copy<2, true>(src, srcStride, dst, dstStride, n) : copy<2, false>(src, srcStride, dst, dstStride, n); break;
+			case 4: swapEndian ? copy<4, true>(src, srcStride, dst, dstStride, n) : copy<4, false>(src, srcStride, dst, dstStride, n); break;
+			case 8: swapEndian ? copy<8, true>(src, srcStride, dst, dstStride, n) : copy<8, false>(src, srcStride, dst, dstStride, n); break;
+			default:
+				for(std::size_t i = 0; i < n; i++)
+				{
+					std::memcpy(dst + i * dstStride, src + i * srcStride, size);
+					if(swapEndian)
+						std::reverse(dst + i * dstStride, dst + i * dstStride + size);
+				}
+			}
+		}
+
+		// calls fn with a null pointer of the plain number type with the given type index,
+		// false for all other types
+		template<typename Fn>
+		inline bool number(
+            const std::type_index& tid,
+            Fn&& fn)
+		{
+			auto is = [&tid, &fn] (auto* x) {
+				if(tid != typeid(*x))
+					return false;
+				fn(x);
+				return true;
+			};
+			return is((std::int8_t*)nullptr) || is((std::uint8_t*)nullptr)
+                || is((std::int16_t*)nullptr) || is((std::uint16_t*)nullptr)
+                || is((std::int32_t*)nullptr) || is((std::uint32_t*)nullptr)
+                || is((float*)nullptr) || is((double*)nullptr);
+		}
+
+		// converts n values of type F from src (srcStride bytes apart) to contiguous values of type T at
+		// dst like static_cast, uint8 to floating point is normalized to [0, 1]. floating point to integer
+		// is clamped to the range of T (nan is 0), double to float beyond the range of float is +-inf,
+		// so every value has a defined result. the values are gathered (and swapped) chunk by chunk,
+		// the conversion of a chunk is a plain loop that is vectorized.
+		template<typename F, typename T>
+		inline void convert(
+            const char* src,
+            std::size_t srcStride,
+            T* dst,
+            std::size_t n,
+            bool swapEndian)
+		{
+			F tmp[1024];
+			constexpr std::size_t chunk = sizeof(tmp) / sizeof(F);
+			for(std::size_t i = 0; i < n; i += chunk)
+			{
+				auto m = std::min(chunk, n - i);
+				stridedCopy(src + i * srcStride, srcStride, reinterpret_cast<char*>(tmp), sizeof(F), m, sizeof(F), swapEndian);
+				auto to = dst + i;
+				if constexpr(std::is_same_v<F, std::uint8_t> && std::is_floating_point_v<T>)
+					for(std::size_t j = 0; j < m; j++)
+						to[j] = static_cast<T>(tmp[j]) * (T(1) / T(255));
+				else if constexpr(std::is_floating_point_v<F> && std::is_integral_v<T>)
+				{ // [lo, hi) truncates, both are powers of two and exact in F
+					constexpr auto lo = static_cast<F>(std::numeric_limits<T>::min());
+					constexpr auto hi = static_cast<F>(std::numeric_limits<T>::max() / 2 + 1) * 2;
+					for(std::size_t j = 0; j < m; j++)
+					{
+						auto x = tmp[j];
+						to[j] = x >= lo && x < hi
+							? static_cast<T>(x)
+							: x >= hi
+								? std::numeric_limits<T>::max()
+								: x < lo
+									? std::numeric_limits<T>::min()
+									: T(0);
+					}
+				}
+				else if constexpr(sizeof(F) > sizeof(T) && std::is_floating_point_v<T>)
+				{ // double to float
+					constexpr auto max = static_cast<F>(std::numeric_limits<T>::max());
+					for(std::size_t j = 0; j < m; j++)
+					{
+						auto x = tmp[j];
+						to[j] = x > max
+							? std::numeric_limits<T>::infinity()
+							: x < -max
+								? -std::numeric_limits<T>::infinity()
+								: static_cast<T>(x);
+					}
+				}
+				else
+					for(std::size_t j = 0; j < m; j++)
+						to[j] = static_cast<T>(tmp[j]);
+			}
+		}
+
+		// converts between the plain number types by type index (see above), false if one is no number
+		inline bool convert(
+            const std::type_index& from,
+            const char* src,
+            std::size_t srcStride,
+            const std::type_index& to,
+            void* dst,
+            std::size_t n,
+            bool swapEndian)
+		{
+			bool done = false;
+			number(from, [&] (auto* f) {
+				done = number(to, [&] (auto* t) {
+					using F = std::remove_pointer_t<decltype(f)>;
+					using T = std::remove_pointer_t<decltype(t)>;
+					convert<F, T>(src, srcStride, static_cast<T*>(dst), n, swapEndian);
+				});
+			});
+			return done;
+		}
+
+		// interleaves K columns of n values of size N into rows that are stride bytes apart
+		template<std::size_t N, std::size_t K, bool swapEndian>
+		inline void gather(
+            const char* const* srcs,
+            char* dst,
+            std::size_t stride,
+            std::size_t n)
+		{
+			auto rows = [srcs, dst, n] (auto step, auto swap) {
+				for(std::size_t i = 0; i < n; i++)
+					for(std::size_t k = 0; k < K; k++)
+					{
+						uintX<N> x;
+						std::memcpy(&x, srcs[k] + i * N, N);
+						if constexpr(decltype(swap)::value)
+							x = byteswap(x);
+						std::memcpy(dst + i * step + k * N, &x, N);
+					}
+			};
+			if(stride == K * N)
+			{ // dense rows with a constant stride can be vectorized and swapped in bulk
+				rows(std::integral_constant<std::size_t, K * N>(), std::false_type());
+				if constexpr(swapEndian)
+					byteswapBlock<N>(dst, n * K);
+			}
+			else
+				rows(stride, std::bool_constant<swapEndian>());
+		}
+		template<std::size_t N, bool swapEndian>
+		inline void interleave(
+            const char* const* srcs,
+            std::size_t k,
+            char* dst,
+            std::size_t stride,
+            std::size_t n)
+		{
+			switch(k)
+			{
+			case 2: gather<N, 2, swapEndian>(srcs, dst, stride, n); break;
+			case 3: gather<N, 3, swapEndian>(srcs, dst, stride, n); break;
+			case 4: gather<N, 4, swapEndian>(srcs, dst, stride, n); break;
+			default:
+				for(std::size_t c = 0; c < k; c++)
+					copy<N, swapEndian>(srcs[c], N, dst + c * N, stride, n);
+			}
+		}
+
+		// interleaves k columns of n values of a given size into rows (column c starts at dst + c * size)
+		inline void interleave(
+            const char* const* srcs,
+            std::size_t k,
+            std::size_t size,
+            char* dst,
+            std::size_t stride,
+            std::size_t n,
+            bool swapEndian)
+		{
+			switch(size)
+			{
+			case 4: swapEndian ? interleave<4, true>(srcs, k, dst, stride, n) : interleave<4, false>(srcs, k, dst, stride, n); break;
+			case 8: swapEndian ? interleave<8, true>(srcs, k, dst, stride, n) : interleave<8, false>(srcs, k, dst, stride, n); break;
+			default:
+				for(std::size_t c = 0; c < k; c++)
+					stridedCopy(srcs[c], size, dst + c * size, stride, n, size, swapEndian);
+			}
+		}
+
+		// index of the first of n values of size N (stride bytes apart) that differs from x, n if there is none
+		template<std::size_t N>
+		inline std::size_t mismatch(
+            const char* src,
+            std::size_t stride,
+            std::size_t n,
+            const char* x)
+		{
+			uintX<N> ref;
+			std::memcpy(&ref, x, N);
+			bool same = true;
+			for(std::size_t i = 0; i < n; i++)
+			{ // no early exit, keeps the loop vectorizable
+				uintX<N> v;
+				std::memcpy(&v, src + i * stride, N);
+				same &= v == ref;
+			}
+			if(same)
+				return n;
+			for(std::size_t i = 0; i < n; i++)
+				if(std::memcmp(src + i * stride, x, N))
+					return i;
+			return n;
+		}
+		inline std::size_t mismatch(
+            const char* src,
+            std::size_t stride,
+            std::size_t n,
+            const char* x,
+            std::uint8_t size)
+		{
+			switch(size)
+			{
+			case 1: return mismatch<1>(src, stride, n, x);
+			case 2: return mismatch<2>(src, stride, n, x);
+			case 4: return mismatch<4>(src, stride, n, x);
+			default: throw std::runtime_error(std::format("Invalid list index type size: {}", size));
+			}
+		}
+
+		// decodes a list index (number of values in a row) of 1, 2 or 4 bytes
+		inline std::size_t listIndex(
+            const char* src,
+            std::uint8_t size,
+            bool swapEndian)
+		{
+			switch(size)
+			{
+			case 1:
+				return static_cast<std::uint8_t>(*src);
+			case 2:
+			{
+				uintX<2> x; std::memcpy(&x, src, 2); return swapEndian ? byteswap(x) : x;
+			}
+			case 4:
+			{
+				uintX<4> x; std::memcpy(&x, src, 4); return swapEndian ? byteswap(x) : x;
+			}
+			default: throw std::runtime_error(std::format("Invalid list index type size: {}", size));
+			}
+		}
+
+		// thrown if ascii data ends inside of a row
+		struct truncated : public std::runtime_error
+		{
+			truncated() : std::runtime_error("unexpected end of ascii data") {}
+		};
+
+		// thrown if a line of an ascii body does not hold exactly one row (see root::readLines)
+		struct misaligned : public std::runtime_error
+		{
+			using std::runtime_error::runtime_error;
+		};
+
+		// classes of characters in ascii bodies: 1 whitespace, 2 one of str::ignoreLineSymbols, 0 others
+		inline constexpr auto charClass = [] () {
+			std::array<std::uint8_t, 256> c{};
+			for(auto x : std::string_view(" \t\n\r\v\f"))
+				c[static_cast<unsigned char>(x)] = 1;
+			for(auto x : std::string_view(str::ignoreLineSymbols))
+				c[static_cast<unsigned char>(x)] = 2;
+			return c;
+		}();
+
+		// skips whitespace and the rest of a line after one of str::ignoreLineSymbols
+		inline const char* skipSpace(
+            const char* first,
+            const char* last)
+		{
+			while(first != last)
+			{
+				auto c = charClass[static_cast<unsigned char>(*first)];
+				if(c == 1)
+					first++;
+				else if(c == 2)
+					while(first != last && *first != str::cr && *first != str::lf)
+						first++;
+				else
+					break;
+			}
+			return first;
+		}
+
+		// row offsets of an element with rows of a fixed size (see rowindex)
+		inline void strideOffsets(
+            std::vector<std::size_t>& offsets,
+            std::size_t step,
+            std::size_t size,
+            std::size_t stride)
+		{
+			for(std::size_t i = 0; i < size; i += step)
+				offsets.push_back(i * stride);
+			offsets.push_back(size * stride);
+		}
+
+		// moves the row offsets of an element (from its first row) behind base, which becomes its end
+		inline void rebase(
+            std::vector<std::size_t>& offsets,
+            std::size_t& base)
+		{
+			for(auto & o : offsets)
+				o += base;
+			base = offsets.back();
+		}
+
+		// skips one value after optional whitespace without parsing it, returns the end of it
+		inline const char* skipToken(
+            const char* first,
+            const char* last)
+		{
+			first = skipSpace(first, last);
+			if(first == last)
+				throw truncated();
+			while(first != last && !charClass[static_cast<unsigned char>(*first)])
+				first++;
+			return first;
+		}
+
+		// parses one number after optional whitespace without locale, returns the end of it
+		template<typename T>
+		inline const char* fromChars(
+            const char* first,
+            const char* last,
+            T& x)
+		{
+			first = skipSpace(first, last);
+			if(first == last)
+				throw truncated();
+			if(*first == '+')
+				first++;
+			std::from_chars_result r;
+			if constexpr(sizeof(T) == 1)
+			{ // chars are numbers, not characters
+				int v = 0;
+				r = std::from_chars(first, last, v);
+				x = static_cast<T>(v);
+			}
+			else
+				r = std::from_chars(first, last, x);
+			if(r.ec != std::errc())
+				throw std::runtime_error(std::format("cannot parse ascii value \"{}\"", std::string_view(first, std::find_if(first, last, [] (char c) { return c == ' ' || c == '\n' || c == '\r'; }))));
+			return r.ptr;
+		}
+
+		// writes one number into [first, first + 32) without locale, returns the end of it.
+		// floats use str::f32digits / str::f64digits or the shortest representation that reads back exactly.
+		template<typename T>
+		inline char* toChars(
+            char* first,
+            T x,
+            bool shortest)
+		{
+			std::to_chars_result r;
+			if constexpr(std::is_floating_point_v<T>)
+				r = shortest
+                    ? std::to_chars(first, first + 32, x)
+                    : std::to_chars(first, first + 32, x, std::chars_format::general, std::is_same_v<T, float> ? str::f32digits : str::f64digits);
+			else if constexpr(sizeof(T) == 1)
+				r = std::to_chars(first, first + 32, static_cast<int>(x));
+			else
+				r = std::to_chars(first, first + 32, x);
+			return r.ptr;
+		}
+
+		// encodes a list index (number of values in a row) of 1, 2 or 4 bytes
+		inline void listIndex(
+            char* dst,
+            std::size_t n,
+            std::uint8_t size,
+            bool swapEndian)
+		{
+			switch(size)
+			{
+			case 1:
+			{
+				auto x = static_cast<uintX<1>>(n); std::memcpy(dst, &x, 1);
+			} break;
+			case 2:
+			{
+				auto x = static_cast<uintX<2>>(n); if(swapEndian) x = byteswap(x); std::memcpy(dst, &x, 2);
+			} break;
+			case 4:
+			{
+				auto x = static_cast<uintX<4>>(n); if(swapEndian) x = byteswap(x); std::memcpy(dst, &x, 4);
+			} break;
+			default: throw std::runtime_error(std::format("Invalid list index type size: {}", size));
+			}
+		}
+	}
+
+	// strided read only access to values of a property that are stored
+	// row by row, e.g. directly inside a memory mapped file (see root::map)
+	template<typename T>
+	struct strided
+	{
+		struct iterator
+		{
+			using iterator_category = std::input_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = T;
+
+			T operator*() const { T x; std::memcpy(&x, ptr_, sizeof(T)); return x; }
+			iterator& operator++() { ptr_ += stride_; return *this; }
+			iterator operator++(int) { auto r = *this; ptr_ += stride_; return r; }
+			bool operator==(iterator const & o) const { return ptr_ == o.ptr_; }
+
+			const char* ptr_ = nullptr;
+			std::size_t stride_ = 0;
+		};
+
+		strided() = default;
+		strided(
+            const char* data,
+            std::size_t size,
+            std::size_t stride) : data_(data), size_(size), stride_(stride) {}
+
+		// values are copied out because rows are not aligned in general
+		T operator[](std::size_t i) const { T x; std::memcpy(&x, data_ + i * stride_, sizeof(T)); return x; }
+		std::size_t size() const { return size_; }
+		std::size_t stride() const { return stride_; }
+		const char* data() const { return data_; }
+		iterator begin() const { return {data_, stride_}; }
+		iterator end() const { return {data_ + size_ * stride_, stride_}; }
+
+	private:
+		const char* data_ = nullptr;
+		std::size_t size_ = 0;
+		std::size_t stride_ = 0;
+	};
+
+	// property list as one contiguous array of values plus row offsets (compressed sparse rows)
+	// instead of std::vector<std::vector<T>>, row i is values[offsets[i], offsets[i + 1]).
+	// if all rows have the same number of values (e.g. triangles), arity is that number,
+	// offsets is empty and row i is values[i * arity, (i + 1) * arity).
+	// (offsets and arity are inherited from internal::flatrows)
+	template<typename T>
+	struct flatlist : public internal::flatrows
+	{
+		std::vector<T> values;
+
+		std::span<T> operator[](std::size_t i) { return {values.data() + first(i), count(i)}; }
+		std::span<T const> operator[](std::size_t i) const { return {values.data() + first(i), count(i)}; }
+		std::size_t size() const { return arity ? values.size() / arity : offsets.empty() ? 0 : offsets.size() - 1; }
+	};
+
+	// Custom data types can be registered via
+	// template<typename T, bool isList> struct CustomIO : public IO
+	// and registerType<type, CustomIO>();
+	// see IO_X later in the code.
+	struct type
+	{
+		// Serialize & Deserialize
+		virtual void ascI(
+            std::istream&,
+            void*,
+            std::size_t) const = 0;
+		virtual void ascO(
+            std::ostream&,
+            const void*,
+            std::size_t) const = 0;
+		virtual void binI(
+            std::istream&,
+            void*,
+            std::size_t,
+            std::uint8_t,
+            bool) const = 0;
+		virtual void binO(
+            std::ostream&,
+            const void*,
+            std::size_t,
+            std::uint8_t,
+            bool) const = 0;
+
+		// First name will be used when writing, all names are valid for reading
+		virtual std::vector<std::string_view> names() const = 0;
+
+		// Size of one value in binary files if it is stored as plain memory of T
+		// (byte swapped for the other endianness), 0 if binI/binO must be used.
+		// Non zero values enable block decoding.
+		virtual std::size_t binSize() const { return 0; }
+
+		// Optional ascii codec on plain characters, used instead of ascI/ascO if chars() is true.
+		// parse reads one value (a whole row for lists) after optional whitespace and returns
+		// the end of it, print appends one value (floats as short as possible if requested).
+		virtual bool chars() const { return false; }
+		virtual const char* parse(
+            const char* first,
+            const char*,
+            void*,
+            std::size_t) const { return first; }
+		virtual void print(
+            std::string&,
+            const void*,
+            std::size_t,
+            bool) const {}
+
+		// Optional block decoder of property lists with binSize() != 0, used instead of binI if
+		// blockLists() is true. binRows gives rows [first, first + n) k values each, the values of
+		// the first row are at src and rows are stride bytes apart.
+		virtual bool blockLists() const { return false; }
+		virtual void binRows(
+            const char*,
+            std::size_t,
+            void*,
+            std::size_t,
+            std::size_t,
+            std::size_t,
+            bool) const {}
+
+		// Optional binary encoder into memory, used instead of binO if packs() is true.
+		// pack appends one value (a whole row with list index for lists) like binO would write it.
+		virtual bool packs() const { return false; }
+		virtual void pack(
+            std::string&,
+            const void*,
+            std::size_t,
+            std::uint8_t,
+            bool) const {}
+
+		// Do not touch
+		virtual ~type() = default;
+	};
+
+	struct prop
+	{
+		friend root; // friends are nice.
+		friend elem;
+		friend reader;
+		friend writer;
+		friend typed;
+
+        // how many datapoints are in the property?
 		std::size_t size() const;
-        
-        // get the name of the element
+
+        // whats my name?
 		std::string_view name() const;
-        
-        // get all the properties from this element
-		std::vector<std::reference_wrapper<prop>> properties();
-        
-        // get all names of the properties
-		std::vector<std::string> names() const;
-        
-        // delete a property by name
-		void del(std::string_view);
 
-	private:
-		template<
-            format ff = format::ascii,
-            std::endian ee = std::endian::native>
-		void read(std::istream &);
+        // mutable data access
+		template<typename T> std::span<T> get();
+
+        // data as T, if another plain number type is stored the values are converted once (like
+        // root::convert, also straight out of a memory mapped file) and the property has type T
+		template<typename T> std::span<T> getAs();
+
+        // set data
+		template<typename T> void set(std::span<T const>);
+		template<typename T> void set(std::vector<T> const &);
+
+        // set data without a copy, the vector (std::vector<T> per row for lists) or flatlist<T>
+        // must have size() rows, the old data goes to the pool (see root::recycle)
+		template<typename T> void set(std::vector<T> &&);
+		template<typename T> void set(flatlist<T> &&);
+
+        // no data of its own, writes read the values straight from memory that the caller keeps
+        // alive and unchanged while the property exists (or until the next set/read), like a
+        // memory mapped property (see view<T>, get<T> copies the values into the property)
+		template<typename T> void borrow(std::span<T const>);
+
+        // moves the data out without a copy and deletes the property (like elem::del)
+		template<typename T> std::vector<T> take();
+		template<typename T> flatlist<T> takeFlat();
+
+        // read only access without copy, only for properties loaded via root::map or borrowed
+		template<typename T> strided<T> view() const;
+
+        // property lists as offsets + values, converts std::vector<std::vector<T>> storage
+        // (and get<std::vector<T>>() converts back)
+		template<typename T> flatlist<T>& flat();
+
+        // is true if the property list is stored as flatlist<T>
+		bool isFlat() const;
+
+        // is true if the data still lives in the memory mapped file (see root::map) or is borrowed
+		bool mapped() const;
+
+        // gets the type of the property
+		std::type_index type() const;
+
+        // for lists, this is std::vector<type>, for non lists, this is equal to type()
+		std::type_index listType() const;
+
+         // is true if the property is a property list
+		bool isList() const;
+
+        // start adress of data
+		void* rawPtr();
+
+        // data size in bytes
+		std::size_t rawSize();
+
+	private:
+		void materialize();
+        // initializes the type or checks it for a set / borrow of new data, drops the old data
+		void replace(
+            const std::type_index&,
+            std::string_view);
+        // converts the values to another plain number type
+		void convert(
+            const std::type_index&);
+
+		std::any        data_;
+		elem*           parent_ = nullptr;
+		std::type_index tid_ = typeid(void);
+		std::uint8_t    listIndexSize_ = 0; // only used when reading files
+		bool            skip_ = false; // only used when reading files, the values are skipped without data
+		std::type_index as_ = typeid(void); // only used when reading files, the type the values are converted to (see root::convert)
+		bool            fused_ = false; // only used when reading files, data_ has type as_ already and the decoders convert
+		const char*     view_ = nullptr; // first value inside the memory mapped file or the borrowed memory
+		std::size_t     stride_ = 0; // distance between two values inside the memory mapped file
+	};
+
+	struct elem
+	{
+		friend root;
+		friend prop;
+		friend reader;
+		friend writer;
+		friend typed;
+
+        // access only, returns element that matches the earliest name in the list
+		prop& operator()(
+            std::span<const std::string_view>);
+		// full initialisation
+        prop& operator()(
+            std::string_view,
+            const std::type_index&);
+        // partial initialisation (full after first Property.get<T>())
+		prop& operator()(
+            std::string_view);
+        
+        // check if property exists
+		bool has(std::string_view) const;
+        
+        // get the number of elements
+		std::size_t size() const;
+        
+        // get the name of the element
+		std::string_view name() const;
+        
+        // get all the properties from this element
+		std::vector<std::reference_wrapper<prop>> properties();
+        
+        // get all names of the properties
+		std::vector<std::string> names() const;
+        
+        // delete a property by name
+		void del(std::string_view);
+
+	private:
+        // like operator()(name, tid) but without allocating the data
+		prop& declare(
+            std::string_view,
+            const std::type_index&);
+
+        // binary: the offset (from the first row) of every step-th row and the end of the
+        // rows are appended to offsets (see rowindex)
+		template<
+            format ff = format::ascii,
+            std::endian ee = std::endian::native>
+		void read(
+            std::istream &,
+            std::size_t = 0,
+            std::vector<std::size_t>* = nullptr);
+
+        // decodes the binary rows [first, last) of an element with rows of a fixed size (see
+        // root::stride) from src, which points to row first
+		void readRows(
+            const char*,
+            std::size_t,
+            std::size_t,
+            bool) const;
+
+        // parses the rows [first, last) of a sanitized ascii body with one row per line,
+        // lines[i] is the start of row i. flat lists go to the flatlist<T> in locals
+        // (rows relative to first). throws internal::misaligned if a line does not hold exactly
+        // one row.
+		void readLines(
+            std::string_view,
+            const std::size_t*,
+            std::size_t,
+            std::size_t,
+            std::vector<std::any>&) const;
+
+        // parses row i of an ascii body from [first, last) and returns the end of it, flat lists are
+        // filled at row fi. throws internal::truncated if the row does not end before last.
+		const char* parseRow(
+            const char*,
+            const char*,
+            std::size_t,
+            std::size_t,
+            const std::vector<const type *>&,
+            const std::vector<const type *>&,
+            const std::vector<void*>&,
+            std::vector<internal::flatfill>&) const;
+
+        // parses the ascii rows [first, size()) from the inbuf without copying the body,
+        // the rows before first are already decoded (flat lists included)
+		void parseRows(
+            internal::inbuf&,
+            std::size_t);
+
+        // list index sizes per property are computed from the data if none are given,
+        // binary row offsets are recorded like in read
+		template<
+            format ff = format::ascii,
+            std::endian ee = std::endian::native>
+		void write(
+            std::ostream &,
+            std::span<const std::uint8_t> = {},
+            std::size_t = 0,
+            std::vector<std::size_t>* = nullptr) const;
+
+		std::unordered_map<
+            const prop*,
+            std::string>            names_;
+		std::vector<std::string>    order_;
+		root*                       parent_ = nullptr;
+
+		std::unordered_map<
+            std::string,
+            prop>                   properties_;
+
+		std::size_t                 size_ = 0;
+	};
+
+	// where the parts of a file are, see root::probe
+	struct layout
+	{
+		struct element
+		{
+			std::string name;
+			std::size_t size = 0; // number of rows
+			std::size_t offset = 0; // byte offset of the first row, 0 if unknown
+			std::size_t stride = 0; // bytes per row, 0 if the rows have a variable size
+		};
+		format               fmt = format::ascii;
+		std::endian          endian = std::endian::native;
+		std::size_t          body = 0; // byte offset of the first byte after the header
+		std::vector<element> elements; // in file order
+	};
+
+	// byte offsets of every step-th row of the elements of a binary file, from the first byte
+	// after the header. a sidecar that is built by a binary read/write (see root::indexRows)
+	// and lets reader::seek jump into elements with lists.
+	struct rowindex
+	{
+		std::size_t step = 0;
+		std::unordered_map<
+            std::string,
+            std::vector<std::size_t>> offsets; // rows 0, step, 2 * step, ... and the end of each element
+
+        // save the index as a text file: "step n", then one line "name count offsets..." per element
+		void save(
+            const std::string&) const;
+        // load a saved index
+		void load(
+            const std::string&);
+	};
+
+	// keeps the columns of dropped properties and hands them to the next read instead of
+	// allocating new ones (see root::recycle), so loading many meshes of a similar size does
+	// not allocate in the steady state. can be shared by roots on different threads.
+	struct pool
+	{
+        // release all kept columns
+		void clear();
+
+        // number of kept columns
+		std::size_t size() const;
+
+        // allocated bytes of the kept columns
+		std::size_t bytes() const;
+
+        // old limit = limit(new limit), the most bytes that are kept, the oldest columns are
+        // released first and larger ones are not kept at all. default is 256 MiB
+		std::size_t limit(std::size_t);
+
+	private:
+		friend root;
+
+		struct kept
+		{
+			std::any      data;
+			std::size_t   bytes = 0;
+			std::uint64_t serial = 0; // order of the drops
+		};
+
+        // takes the oldest columns out until at most limit_ bytes are kept, they are
+        // released by the caller after unlocking
+		std::vector<std::any> trim();
+
+		mutable std::mutex mutex_;
+		std::unordered_map<
+            std::type_index,
+            std::deque<kept>>       columns_; // std::vector<T> by property type, oldest first
+		std::unordered_map<
+            std::type_index,
+            std::deque<kept>>       flat_; // flatlist<T> by property type, oldest first
+		std::size_t                 bytes_ = 0;
+		std::size_t                 limit_ = std::size_t(1) << 28;
+		std::uint64_t               serial_ = 0;
+	};
+
+	// what a root reports to its instrumentation sink (see root::instrument)
+	struct event
+	{
+		enum class phase : std::uint8_t
+		{
+			header,   // parsing or writing the header
+			allocate, // creating the column of a property (name is "element.property")
+			decode,   // decoding rows of an element, threaded runs over several elements are one event ("a,b")
+			encode    // encoding the rows of an element
+		};
+
+		phase            what = phase::header;
+		std::string_view name; // of the element (or property), empty for the header
+		double           seconds = 0; // wall time
+		std::size_t      bytes = 0; // of the file (0 if the stream cannot tell), of the column for allocate (0 for lists)
+		std::size_t      rows = 0;
+		std::size_t      allocations = 0; // columns that were not taken from the pool
+	};
+
+	struct root
+	{
+		friend elem;
+		friend prop;
+		friend reader;
+		friend writer;
+		friend typed;
+
+		root();
+        // gives the columns back to the pool (see recycle)
+		~root();
+
+        // full init
+		elem& operator()(
+            std::string_view,
+            std::size_t);
+        // access only after init
+		elem& operator()(
+            std::string_view);
+        // const access
+		const elem& operator()(
+            std::string_view) const;
+
+        // get all the comments and manage them yourself
+		std::vector<std::string>& comments();
+
+        // load a file (do not forget std::ios::binary!). a stream that can seek ends after the
+        // body, one that cannot (pipe, socket) after the last binary row, ascii bodies and
+        // prefetch read ahead up to a block.
+		void read(
+            std::istream&);
+        // load a file
+		void read(
+            const std::string&);
+
+        // load a file with the same elements & properties (same order & types, the number of
+        // rows may change) into the existing ones, their storage is reused. throws if the
+        // header does not match (everything stays unchanged), not together with select or convert.
+		void reload(
+            std::istream&);
+        // reload from a file
+		void reload(
+            const std::string&);
+
+        // load a file via a read only memory mapping. properties of binary files with native
+        // endianness that are not lists and whose elements are not lists stay inside the
+        // mapping (see prop::view<T>), all others are decoded. the mapping lives until the
+        // next read/map or until the root is destroyed.
+		void map(
+            const std::string&);
+        
+        // add a custom datatype
+		template<
+            typename T,
+            template<typename, bool> typename CustomIO>
+        void registerType();
+		
+        // parse only the header: declares all elements & properties (without data) and the
+        // comments. offset and stride of a binary element are known as long as all elements
+        // before it have fixed size rows (no lists). the body is never read.
+		layout probe(
+            std::istream&);
+        // parse only the header of a file
+		layout probe(
+            const std::string&);
+
+        // write a file to utput stream. binary with indexRows: the row offsets are recorded in
+        // the rowindex, if one is given
+        template<
+            format ff = format::ascii,
+            std::endian ee = std::endian::native>
+		void write(
+            std::ostream &,
+            rowindex* = nullptr) const;
+
+        // write a file
+		template<
+            format ff = format::ascii,
+            std::endian ee = std::endian::native>
+        void write(
+            const std::string&,
+            rowindex* = nullptr) const;
+		
+        // get ascii representation of the ply
+        std::string str() const;
+		
+        // old line seperator = lineSeperator(new line seperator)
+        char lineSeperator(char);
+
+        // old setting = flatLists(new setting), true: property lists of files
+        // are read as flatlist<T> (see prop::flat<T>), default is false. binary lists with
+        // a fixed arity are decoded block by block either way, nested lists still allocate
+        // every row (see recycle).
+        bool flatLists(bool);
+
+        // old setting = threads(new setting), number of threads used for reading ascii rows
+        // and binary elements with rows of a fixed size (elements with lists are decoded
+        // serially), 0 uses all hardware threads, default is 1
+        unsigned threads(unsigned);
+
+        // old setting = prefetch(new setting), true: a second thread reads the next blocks of
+        // a stream while the blocks before are decoded (for sources with a high latency),
+        // default is false
+        bool prefetch(bool);
+
+        // old pool = recycle(new pool), columns of dropped properties (read again, del or
+        // destroyed) go to the pool and read/map take theirs from it. the decoders overwrite
+        // every row, list rows keep their capacity too. nullptr (default) allocates every time.
+        std::shared_ptr<pool> recycle(std::shared_ptr<pool>);
+
+        // old setting = shortestFloats(new setting), true: floats in ascii files are written
+        // as short as possible while reading back exactly, default is false (9 / 17 digits)
+        bool shortestFloats(bool);
+
+        // old selection = select(new selection), only the selected elements ("vertex") and
+        // properties ("vertex.x") are kept by read/map, plain values of the others are skipped
+        // without decoding and nothing after the last selected element is read. empty keeps
+        // everything (default).
+        std::vector<std::string> select(std::vector<std::string>);
+
+        // old conversions = convert(new conversions), the plain number properties ("vertex.x")
+        // are read as the given plain number type (e.g. typeid(float) for double positions) like
+        // static_cast, uint8 to float or double is normalized to [0, 1], float or double to an
+        // integer is clamped to its range (nan is 0) and double beyond float is +-inf. binary
+        // elements with rows of a fixed size are converted while decoding, without a column of
+        // the stored type, all others after decoding. empty converts nothing (default).
+        std::unordered_map<std::string, std::type_index> convert(std::unordered_map<std::string, std::type_index>);
+
+        // old step = indexRows(new step), != 0: binary read/map record the offset of every
+        // step-th row of each element in index(), write in the rowindex it is given, default is 0
+        std::size_t indexRows(std::size_t);
+
+        // the row offsets of the last binary read/map with indexRows
+        const rowindex& index() const;
+
+        // old sink = instrument(new sink), read/map/write report the time, bytes and rows of the
+        // header, of every element and of every allocated column to the sink (see event). the
+        // events are only measured if there is a sink, nullptr (default) costs nothing.
+        std::function<void(const event&)> instrument(std::function<void(const event&)>);
+		
+        // get all the elements
+        std::vector<std::reference_wrapper<elem>> elements();
+		
+        // get all element names
+        std::vector<std::string> names() const;
+		
+        // delete an element by name
+        void del(std::string_view);
+		
+        // check if element exists
+        bool has(std::string_view) const;
+		
+        // check if element with property exists
+        bool has(
+            std::string_view,
+            std::string_view) const;
+
+	private:
+		std::type_index typeidFromStr(
+            std::string_view,
+            bool);
+
+        // parses the header and declares all elements & properties (without data), or
+        // only checks them against the existing ones and updates the sizes if keep is true
+		std::pair<format, std::endian> readHeader(
+            std::istream&,
+            bool = false);
+		void readBody(
+            std::istream&,
+            format,
+            std::endian);
+        // writes everything up to end_header, lists without data use their listIndexSize_
+		template<
+            format ff,
+            std::endian ee>
+		void writeHeader(
+            std::ostream &) const;
+        // bytes per binary row of an element, 0 if the rows have a variable size
+		std::size_t stride(
+            const elem&) const;
+        // creates the data of all properties of an element
+		void allocate(
+            elem&);
+        // gives the data of a property to the pool
+		void drop(
+            prop&);
+        // marks the properties that are not selected as skipped and drops the elements
+        // after the last selected one (see select), prune deletes the unselected rest
+		void project();
+		void prune();
+        // marks the properties to convert (see convert), settle converts those that were not
+        // converted while decoding and gives all of them their new type
+		void retype(
+            format);
+		void settle();
+		bool selected(
+            std::string_view,
+            std::string_view) const;
+        // gives a phase that started at start to the sink (see instrument)
+		void report(
+            event::phase,
+            std::string_view,
+            std::chrono::steady_clock::time_point,
+            std::size_t,
+            std::size_t,
+            std::size_t = 0) const;
+        // decodes the binary elements [first, last) with rows of a fixed size block by block on
+        // multiple threads, the rows of each block are split into tasks
+		void readRows(
+            internal::inbuf&,
+            unsigned,
+            std::size_t,
+            std::size_t,
+            bool);
+        // parses an ascii body with one row per line block by block on multiple threads, starting
+        // at row (second) of element (first). stops at the first block whose lines do not match
+        // the rows and leaves both at the first row that is not decoded yet.
+		void readLines(
+            internal::inbuf&,
+            unsigned,
+            std::size_t&,
+            std::size_t&);
+		
+        char linesep_ = str::lf;
+		bool flat_ = false;
+		unsigned threads_ = 1;
+		bool shortest_ = false;
+		bool prefetch_ = false;
+		std::shared_ptr<pool> pool_;
+		std::vector<std::string> select_;
+		std::unordered_map<std::string, std::type_index> convert_;
+		std::size_t indexStep_ = 0;
+		rowindex index_; // of the last read/map
+		std::function<void(const event&)> sink_;
+
+        std::unordered_map<
+            std::type_index,
+            std::function<
+                std::any(std::size_t)>>     anyvec_;
+		std::vector<std::string>            comments_;
+		std::unordered_map<
+            std::string,
+            elem>                           elements_;
+		std::unordered_map<
+            std::type_index,
+            std::unique_ptr<
+                internal::ErasedInfoBase>>  info_;
+		std::unordered_map<
+            std::type_index,
+            std::unique_ptr<type>>          ios_;
+		std::unordered_map<
+            const elem*,
+            std::string>                    names_;
+		std::vector<std::string>            order_;
+		std::shared_ptr<
+            internal::filemap>              map_;
+	};
+
+	// reads a file chunk by chunk with bounded memory. the header is parsed on construction,
+	// next() decodes the following rows of the elements (in file order) into chunk(), whose
+	// properties keep their buffers from chunk to chunk. only the default datatypes are supported.
+	struct reader
+	{
+        // read from a stream (do not forget std::ios::binary!)
+		explicit reader(
+            std::istream&);
+        // read a file
+		explicit reader(
+            const std::string&);
+
+        // the elements & properties of the file without data, elem::size() is the number of rows
+		const root& header() const;
+
+        // old setting = flatLists(new setting), see root::flatLists
+		bool flatLists(bool);
+
+        // old setting = prefetch(new setting), see root::prefetch. only before the first
+        // next() after construction or seek()
+		bool prefetch(bool);
+
+        // decodes up to n rows of the current element into chunk(), continues with the next
+        // element when all rows of it are decoded, returns false after the last element
+		bool next(
+            std::size_t);
+
+        // the rows of the last next(), elem::size() is their number
+		elem& chunk();
+
+        // index of the first row of chunk() inside its element
+		std::size_t first() const;
+
+        // continue at a row of an element, next() decodes the rows from there. the offset is
+        // computed from the header as long as the rows before have a fixed size, rows behind
+        // lists need the rowindex of the file (see root::indexRows). binary only, the stream
+        // has to be seekable.
+		void seek(
+            std::string_view,
+            std::size_t,
+            const rowindex* = nullptr);
+
+	private:
+		void open();
+        // (re)creates the buffers between the stream and the decoding, after seeking to a
+        // position if one is given
+		void rewire(
+            std::streampos = -1);
+
+		std::unique_ptr<std::ifstream>  file_;
+		std::istream*                   in_ = nullptr;
+		std::unique_ptr<
+            internal::prefetchbuf>      pre_;
+		std::unique_ptr<internal::inbuf> buf_;
+		std::unique_ptr<std::istream>   body_;
+		std::streampos                  start_ = -1; // of the body in the stream
+		root                            header_;
+		root                            chunks_;
+		format                          fmt_ = format::ascii;
+		std::endian                     endian_ = std::endian::native;
+		std::size_t                     element_ = 0; // index of the current element
+		std::size_t                     first_ = 0;
+		elem*                           chunk_ = nullptr;
+	};
+
+	// writes a file chunk by chunk without holding the whole model. all elements and properties
+	// are declared up front, then the rows of each element are pushed in declaration order as
+	// elements of any root (e.g. one that is reused for every chunk).
+	struct writer
+	{
+        // write to a stream (do not forget std::ios::binary!)
+		writer(
+            std::ostream&,
+            format,
+            std::endian = std::endian::native);
+        // write a file
+		writer(
+            const std::string&,
+            format,
+            std::endian = std::endian::native);
+
+        // declares the next element with its total number of rows
+		writer& element(
+            std::string_view,
+            std::size_t);
+        // declares a property of the last element, lists need the size of their list index (1, 2 or 4 bytes)
+		writer& property(
+            std::string_view,
+            const std::type_index&,
+            std::uint8_t = 1);
+
+        // get all the comments and manage them yourself
+		std::vector<std::string>& comments();
+
+        // writes the rows of an element with the declared name & properties after the rows written
+        // so far, the header is written with the first rows. throws if there are too many rows or
+        // lists do not fit their list index.
+		void write(
+            const elem&);
+
+        // writes the header if nothing was written yet, throws if rows are missing
+		void finish();
+
+	private:
+        // writes the rows of an element (nullptr: only the header)
+		void write(
+            const elem*);
+		template<
+            format ff,
+            std::endian ee>
+		void put(
+            const elem*);
+		void next();
+
+		std::unique_ptr<std::ofstream>  file_;
+		std::ostream*                   out_ = nullptr;
+		root                            header_;
+		format                          fmt_;
+		std::endian                     endian_;
+		bool                            started_ = false; // header is written
+		bool                            rows_ = false; // any rows are written
+		std::size_t                     element_ = 0; // index of the current element
+		std::size_t                     written_ = 0; // rows of the current element
+	};
+
+	// rows of an element for the compile time codec (see typed). the property types are known
+	// at compile time (the ply types, std::vector<T> for lists), the columns are plain vectors.
+	template<typename... T>
+	struct table
+	{
+		static_assert(sizeof...(T) > 0, "an element needs properties");
+		static_assert((internal::isPlyType<T>::value && ...), "properties are ply number types or std::vector of one");
+
+		std::string                            name;
+		std::array<std::string, sizeof...(T)>  properties; // names
+		std::tuple<std::vector<T>...>          columns;
+		std::array<std::uint8_t, sizeof...(T)> listIndexSizes{}; // from the file when reading, 0 computes them when writing
+
+        // column of property I
+		template<std::size_t I> auto& get() { return std::get<I>(columns); }
+		template<std::size_t I> const auto& get() const { return std::get<I>(columns); }
+
+        // number of rows
+		std::size_t size() const { return std::get<0>(columns).size(); }
+
+        // sets the number of rows of all columns
+		void resize(std::size_t n) { std::apply([n] (auto &... c) { (c.resize(n), ...); }, columns); }
+	};
+
+	// maps the properties of an element to the members of a struct S, whose rows are read into and
+	// written from a std::vector<S> directly (see typed), without a column per property. S is
+	// copied as plain memory, rows of binary files with the same layout as S are copied in bulk.
+	template<typename S>
+	struct binding
+	{
+		static_assert(std::is_trivially_copyable_v<S>, "rows are copied as plain memory");
+
+		struct field
+		{
+			std::string     property;
+			std::type_index tid = typeid(void);
+			std::size_t     offset = 0; // of the member inside S
+			std::size_t     size = 0;
+			const char*     (*parse)(const char*, const char*, void*) = nullptr;
+			void            (*print)(std::string&, const void*) = nullptr;
+		};
+
+		binding(
+            std::string name,
+            std::vector<S>& rows) : name(std::move(name)), rows(&rows) {}
+
+        // binds a property to a member, properties are written in the order they are bound
+		template<typename T> binding& bind(
+            std::string_view,
+            T S::*);
+        // binds a property to a value of type T at a byte offset inside S (e.g. float pos[3])
+		template<typename T> binding& bind(
+            std::string_view,
+            std::size_t);
+
+		std::string        name;
+		std::vector<S>*    rows = nullptr;
+		std::vector<field> fields;
+
+	private:
+		friend typed;
+
+		// the properties of the file as read: bound field (npos if skipped), size & list index size
+		struct slot
+		{
+			std::size_t  field = std::string::npos;
+			std::size_t  size = 0;
+			std::uint8_t listIndexSize = 0;
+		};
+		std::vector<slot> slots_;
+	};
+
+	// reads & writes files whose elements are known at compile time (see table and binding). the
+	// codec of each element is generated for its property types, no type, std::any or virtual calls.
+	struct typed
+	{
+        // read a file whose elements are exactly the tables (same order, names & property
+        // types) or bindings (same order & names, every field with the type of its property,
+        // other plain properties are skipped), throws if the header does not match (do not
+        // forget std::ios::binary!)
+		template<typename... E>
+		static void read(
+            std::istream&,
+            E&...);
+        // read a file
+		template<typename... E>
+		static void read(
+            const std::string&,
+            E&...);
+
+        // write the tables & bindings as the elements of a file
+		template<
+            format ff = format::ascii,
+            std::endian ee = std::endian::native,
+            typename... E>
+		static void write(
+            std::ostream&,
+            const E&...);
+        // write a file
+		template<
+            format ff = format::ascii,
+            std::endian ee = std::endian::native,
+            typename... E>
+		static void write(
+            const std::string&,
+            const E&...);
+
+	private:
+        // checks an element of the header against a table and sizes the columns
+		template<typename... T>
+		static void check(
+            root&,
+            std::size_t,
+            table<T...>&);
+		template<
+            std::endian ee,
+            typename... T>
+		static void decode(
+            internal::inbuf&,
+            table<T...>&);
+        // parses the rows of an element from ascii lines block by block, like elem::parseRows
+		template<typename E>
+		static void parseRows(
+            internal::inbuf&,
+            std::size_t,
+            E&);
+        // parses row i and returns the end of it, throws internal::truncated if the row does
+        // not end before last
+		template<typename... T>
+		static const char* parse(
+            const char*,
+            const char*,
+            std::size_t,
+            table<T...>&);
+		template<typename... T>
+		static void declare(
+            root&,
+            const table<T...>&);
+		template<
+            std::endian ee,
+            typename... T>
+		static void encode(
+            std::ostream&,
+            const table<T...>&);
+		template<typename... T>
+		static void print(
+            std::ostream&,
+            const table<T...>&,
+            bool);
+        // list index sizes for writing, computed from the rows where the table has none
+		template<typename... T>
+		static std::array<std::uint8_t, sizeof...(T)> indexSizes(
+            const table<T...>&);
+
+		template<typename S>
+		static void check(
+            root&,
+            std::size_t,
+            binding<S>&);
+		template<
+            std::endian ee,
+            typename S>
+		static void decode(
+            internal::inbuf&,
+            binding<S>&);
+		template<typename S>
+		static const char* parse(
+            const char*,
+            const char*,
+            std::size_t,
+            binding<S>&);
+		template<typename S>
+		static void declare(
+            root&,
+            const binding<S>&);
+		template<
+            std::endian ee,
+            typename S>
+		static void encode(
+            std::ostream&,
+            const binding<S>&);
+		template<typename S>
+		static void print(
+            std::ostream&,
+            const binding<S>&,
+            bool);
+        // true if the fields cover S in order without gaps, so rows are plain binary rows
+		template<typename S>
+		static bool packed(
+            const binding<S>&);
+	};
+
+	// ---------------------------------------------------------------
+	// Property
+	// ---------------------------------------------------------------
+
+	std::vector<std::reference_wrapper<prop>> elem::properties()
+	{
+		std::vector<std::reference_wrapper<prop>> info;
+		for(auto & [n, p] : properties_)
+			info.emplace_back(p);
+		return info;
+	}
+
+	std::vector<std::string> elem::names() const
+	{
+		std::vector<std::string> info;
+		for(auto & [n, p] : properties_)
+			info.emplace_back(p.name());
+		return info;
+	}
+
+	void* prop::rawPtr()
+	{
+		if(!data_.has_value() && view_)
+			materialize();
+		auto & info = *parent_->parent_->info_[tid_].get();
+		return info.rawPtr(data_);
+	}
+
+	std::size_t prop::rawSize()
+	{
+		auto & info = *parent_->parent_->info_[tid_].get();
+		return info.typeSize() * size();
+	}
+
+	std::size_t prop::size() const
+	{
+		return parent_->size_;
+	}
+	std::string_view prop::name() const
+	{
+		return parent_->names_.at(this);
+	}
+	template<typename T> std::span<T> prop::get()
+	{
+		if(tid_ != typeid(T))
+		{ // late initialization
+			if(tid_ == typeid(void))
+			{
+				tid_ = typeid(T);
+				auto & f = parent_->parent_->anyvec_[tid_];
+				if(!f) throw std::runtime_error(std::format("Unknown type: \"{}\" (size = {})", typeid(T).name(), sizeof(T)));
+				data_ = f(parent_->size_);
+			}
+			else
+				throw std::runtime_error(std::format("Property::get<{}> is incompatible to the stored type \"{}\"", typeid(T).name(), tid_.name()));
+		}
+		if(!data_.has_value() && view_)
+			materialize(); // copy out of the memory mapped file
+		if constexpr(internal::isVector<T>::value)
+		{
+			if(auto f = std::any_cast<flatlist<typename T::value_type>>(&data_))
+			{ // flat to nested
+				std::vector<T> vv(f->size());
+				for(std::size_t i = 0; i < vv.size(); i++)
+					vv[i].assign(f->values.begin() + f->first(i), f->values.begin() + f->first(i) + f->count(i));
+				data_ = std::move(vv);
+			}
+		}
+		return std::any_cast<std::vector<T> &>(data_);
+	}
+	template<typename T> flatlist<T>& prop::flat()
+	{
+		auto & r = *parent_->parent_;
+		if(tid_ == typeid(void))
+		{ // late initialization
+			if(!r.ios_.contains(typeid(std::vector<T>)))
+				throw std::runtime_error(std::format("Unknown type: \"{}\" (size = {})", typeid(T).name(), sizeof(T)));
+			tid_ = typeid(std::vector<T>);
+			data_ = r.info_[tid_]->flat(size());
+		}
+		if(tid_ != typeid(std::vector<T>))
+			throw std::runtime_error(std::format("Property::flat<{}> is incompatible to the stored type \"{}\"", typeid(T).name(), tid_.name()));
+		if(auto f = std::any_cast<flatlist<T>>(&data_))
+			return *f;
+		// nested to flat
+		auto & vv = std::any_cast<std::vector<std::vector<T>> &>(data_);
+		flatlist<T> f;
+		f.offsets.resize(vv.size() + 1);
+		for(std::size_t i = 0; i < vv.size(); i++)
+			f.offsets[i + 1] = f.offsets[i] + vv[i].size();
+		f.values.reserve(f.offsets.back());
+		for(auto & v : vv)
+			f.values.insert(f.values.end(), v.begin(), v.end());
+		data_ = std::move(f);
+		return std::any_cast<flatlist<T> &>(data_);
+	}
+	bool prop::isFlat() const
+	{
+		if(tid_ == typeid(void))
+			return false;
+		return parent_->parent_->info_[tid_]->rows(data_) != nullptr;
+	}
+	template<typename T> strided<T> prop::view() const
+	{
+		if(tid_ != typeid(T))
+			throw std::runtime_error(std::format("Property::view<{}> is incompatible to the stored type \"{}\"", typeid(T).name(), tid_.name()));
+		if(!view_)
+			throw std::runtime_error(std::format("Property::view<{}> is only available for memory mapped or borrowed properties", typeid(T).name()));
+		return strided<T>(view_, size(), stride_);
+	}
+	bool prop::mapped() const
+	{
+		return view_ != nullptr;
+	}
+	void prop::materialize()
+	{
+		auto & r = *parent_->parent_;
+		auto & info = *r.info_[tid_].get();
+		data_ = r.anyvec_[tid_](size());
+		auto dst = static_cast<char*>(info.rawPtr(data_));
+		auto ts = info.typeSize();
+		for(std::size_t i = 0; i < size(); i++)
+			std::memcpy(dst + i * ts, view_ + i * stride_, ts);
+		view_ = nullptr;
+		stride_ = 0;
+	}
+	template<typename T> void prop::set(std::span<T const> src)
+	{
+		auto dst = get<T>();
+		std::copy_n(src.begin(), src.size(), dst.begin());
+	}
+	template<typename T> void prop::set(std::vector<T> const & src)
+	{
+		auto dst = get<T>();
+		std::copy_n(src.begin(), src.size(), dst.begin());
+	}
+	template<typename T> void prop::set(std::vector<T> && src)
+	{
+		if(src.size() != size())
+			throw std::runtime_error(std::format("Property::set got {} rows instead of {}", src.size(), size()));
+		replace(typeid(T), "set");
+		data_ = std::move(src);
+	}
+	template<typename T> void prop::set(flatlist<T> && src)
+	{
+		auto & info = parent_->parent_->info_;
+		std::any data = std::move(src);
+		if(auto it = info.find(typeid(std::vector<T>)); it != info.end())
+			it->second->check(data, size());
+		replace(typeid(std::vector<T>), "set");
+		data_ = std::move(data);
+	}
+	template<typename T> void prop::borrow(std::span<T const> src)
+	{
+		static_assert(!internal::isVector<T>::value, "property lists cannot be borrowed");
+		if(src.size() != size())
+			throw std::runtime_error(std::format("Property::borrow got {} rows instead of {}", src.size(), size()));
+		replace(typeid(T), "borrow");
+		view_ = reinterpret_cast<const char*>(src.data());
+		stride_ = sizeof(T);
+	}
+	template<typename T> std::vector<T> prop::take()
+	{
+		get<T>(); // checks the type, copies mapped or borrowed values and converts flat lists
+		std::vector<T> data = std::move(std::any_cast<std::vector<T> &>(data_));
+		data_.reset();
+		parent_->del(std::string(name()));
+		return data;
+	}
+	template<typename T> flatlist<T> prop::takeFlat()
+	{
+		flatlist<T> data = std::move(flat<T>());
+		data_.reset();
+		parent_->del(std::string(name()));
+		return data;
+	}
+	template<typename T> std::span<T> prop::getAs()
+	{
+		if(tid_ != typeid(T) && tid_ != typeid(void))
+			convert(typeid(T));
+		return get<T>();
+	}
+	void prop::convert(std::type_index const & to)
+	{
+		auto & r = *parent_->parent_;
+		auto & info = *r.info_.at(tid_);
+		auto data = r.anyvec_.contains(to) ? r.anyvec_[to](size()) : std::any();
+		bool mapped = !data_.has_value() && view_;
+		auto src = mapped ? view_ : static_cast<const char*>(info.rawPtr(data_));
+		if(!data.has_value() || !internal::convert(tid_, src, mapped ? stride_ : info.typeSize(), to, r.info_.at(to)->rawPtr(data), size(), false))
+			throw std::runtime_error(std::format("cannot convert property \"{}\" from \"{}\" to \"{}\"", name(), tid_.name(), to.name()));
+		r.drop(*this);
+		data_ = std::move(data);
+		tid_ = to;
+		view_ = nullptr;
+		stride_ = 0;
+	}
+	void prop::replace(std::type_index const & tid, std::string_view what)
+	{
+		auto & r = *parent_->parent_;
+		if(tid_ == typeid(void))
+		{ // late initialization
+			if(!r.anyvec_.contains(tid))
+				throw std::runtime_error(std::format("Unknown type: \"{}\"", tid.name()));
+			tid_ = tid;
+		}
+		else if(tid_ != tid)
+			throw std::runtime_error(std::format("Property::{}<{}> is incompatible to the stored type \"{}\"", what, tid.name(), tid_.name()));
+		r.drop(*this);
+		data_.reset();
+		view_ = nullptr;
+		stride_ = 0;
+	}
+	std::type_index prop::listType() const
+	{
+		return tid_;
+	}
+	std::type_index prop::type() const
+	{
+		return parent_->parent_->info_[tid_]->tid();
+	}
+	bool prop::isList() const
+	{
+		if(tid_ == typeid(void))
+			throw std::runtime_error("Property::isList cannot be used before type initialization");
+		return parent_->parent_->info_[tid_]->isList();
+	};
+
+	// ---------------------------------------------------------------
+	// Element
+	// ---------------------------------------------------------------
+
+	bool elem::has(std::string_view sv) const
+	{
+		return properties_.contains(std::string(sv));
+	}
+
+	prop & elem::operator()(std::string_view name)
+	{
+		auto [it, inserted] = properties_.try_emplace(std::string(name));
+		if(inserted)
+		{
+			order_.push_back(std::string(name));
+			names_[&it->second] = std::string(name);
+			it->second.parent_ = this;
+		}
+		return it->second;
+	}
+
+	prop & elem::operator()(std::string_view name, std::type_index const & tid)
+	{
+		auto inserted = !has(name);
+		auto & p = declare(name, tid);
+		if(inserted)
+			p.data_ = parent_->anyvec_[tid](size_);
+		return p;
+	}
+
+	prop & elem::declare(std::string_view name, std::type_index const & tid)
+	{
+		if(!parent_->ios_.contains(tid))
+			throw std::runtime_error(std::format("No IO defined for type \"{}\"", tid.name()));
+		auto [it, inserted] = properties_.try_emplace(std::string(name));
+		if(inserted)
+		{
+			order_.push_back(std::string(name));
+			names_[&it->second] = std::string(name);
+			it->second.parent_ = this;
+			it->second.tid_ = tid;
+		}
+		return it->second;
+	}
+
+	prop & elem::operator()(std::span<std::string_view const> names)
+	{
+		for(auto const & n : names)
+			if(has(n))
+				return operator()(n);
+		std::string s;
+		for(int i = 0; i < static_cast<int>(names.size()); ++i)
+			s += std::string(names[i]) + (i < static_cast<int>(names.size()) - 1 ? " || " : "");
+		throw std::runtime_error(std::format("Element does not contain property \"{}\"", s));
+	}
+
+	std::size_t elem::size() const
+	{
+		return size_;
+	}
+	std::string_view elem::name() const
+	{
+		return parent_->names_.at(this);
+	}
+
+	void elem::del(std::string_view n)
+	{
+		auto it = properties_.find(std::string(n));
+		if(it == properties_.end())
+			throw std::runtime_error(std::format("cannot delete something that does not exist element.{}", n));
+		parent_->drop(it->second);
+		names_.erase(&it->second);
+		properties_.erase(std::string(n));
+		for(std::size_t i = 0; i < order_.size(); i++)
+		{
+			if(order_[i] == n)
+			{
+				order_.erase(order_.begin() + i);
+				break;
+			}
+		}
+	}
+
+	template<format ff, std::endian ee>
+	void elem::write(std::ostream & out, std::span<std::uint8_t const> listIndexSizes, std::size_t step, std::vector<std::size_t>* offsets) const
+	{
+		std::size_t np = order_.size();
+		std::vector<const type *> ios(np); // serializer & deserializer for each property
+		std::vector<const void*> ptrs(np); // ptr on the vectors (NOT the data)
+		std::vector<std::uint8_t> lsiz(np); // list index type sizes
+		std::vector<std::any> copies(np); // temporary copies of memory mapped or borrowed properties
+		std::vector<const std::any*> datas(np); // data of each property
+		std::vector<const char*> views(np); // contiguous memory mapped or borrowed values that are not copied (yet)
+		std::vector<const internal::flatrows*> rows(np); // rows of flat property lists, nullptr otherwise
+		std::vector<const type *> vios(np); // serializer for the values of flat property lists
+		auto copy = [this, &copies, &datas, &ptrs] (std::size_t pIdx) {
+			auto const & p = properties_.at(order_[pIdx]);
+			auto & info = *parent_->info_[p.tid_].get();
+			copies[pIdx] = parent_->anyvec_[p.tid_](size_);
+			auto dst = static_cast<char*>(info.rawPtr(copies[pIdx]));
+			for(std::size_t i = 0; i < size_; i++)
+				std::memcpy(dst + i * info.typeSize(), p.view_ + i * p.stride_, info.typeSize());
+			datas[pIdx] = &copies[pIdx];
+			ptrs[pIdx] = info.vecPtr(copies[pIdx]);
+		};
+		for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+		{
+			auto const & p = properties_.at(order_[pIdx]);
+			ios[pIdx] = parent_->ios_[p.tid_].get();
+			auto & info = *parent_->info_[p.tid_].get();
+			datas[pIdx] = &p.data_;
+			if(!p.data_.has_value() && p.view_)
+			{
+				if(ff == format::binary && p.stride_ == info.typeSize())
+				{ // written in place if all rows have a fixed size (never lists)
+					views[pIdx] = p.view_;
+					continue;
+				}
+				copy(pIdx);
+			}
+			if(info.isList() && (rows[pIdx] = info.rows(*datas[pIdx])))
+			{
+				info.check(*datas[pIdx], size_);
+				vios[pIdx] = parent_->ios_[info.tid()].get();
+				ptrs[pIdx] = info.values(*datas[pIdx]);
+			}
+			else
+				ptrs[pIdx] = info.vecPtr(*datas[pIdx]);
+			lsiz[pIdx] = listIndexSizes.empty() ? info.listIndexTypeSize(*datas[pIdx]) : listIndexSizes[pIdx];
+		}
+		if constexpr(ff == format::ascii)
+		{
+			// rows are printed into a reusable buffer that is written in large blocks
+			std::size_t const blockSize = std::size_t(1) << 20;
+			bool const shortest = parent_->shortest_;
+			std::string block;
+			block.reserve(blockSize + 256);
+			auto flush = [&block, &out] () {
+				out.write(block.data(), static_cast<std::streamsize>(block.size()));
+				block.clear();
+			};
+			auto print = [&block, &out, &flush, shortest] (const type * io, const void* ptr, std::size_t i) {
+				if(io->chars())
+					io->print(block, ptr, i, shortest);
+				else
+				{
+					flush();
+					io->ascO(out, ptr, i);
+				}
+			};
+			for(std::size_t i = 0; i < size_; i++)
+			{
+				for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+				{
+					if(auto r = rows[pIdx])
+					{
+						char b[32];
+						block.append(b, internal::toChars(b, r->count(i), false));
+						for(auto j = r->first(i); j < r->first(i) + r->count(i); j++)
+						{
+							block += str::space;
+							print(vios[pIdx], ptrs[pIdx], j);
+						}
+					}
+					else
+						print(ios[pIdx], ptrs[pIdx], i);
+					if(pIdx < np - 1) block += str::space;
+				}
+				if(i < size_ - 1) block += parent_->linesep_;
+				if(block.size() >= blockSize)
+					flush();
+			}
+			flush();
+		}
+		else if constexpr(ff == format::binary)
+		{
+			constexpr bool swapEndian = ee != std::endian::native;
+
+			// plain values and lists with a fixed arity give rows of a fixed size that are encoded block by block
+			std::vector<const char*> srcs(np); // element [0] of each property (values for lists)
+			std::vector<std::size_t> offs(np); // offset of each property inside a row
+			std::vector<std::size_t> vsiz(np); // size of the values
+			std::size_t stride = 0;
+			bool fixed = true;
+			for(std::size_t pIdx = 0; fixed && pIdx < np; pIdx++)
+			{
+				auto & info = *parent_->info_[properties_.at(order_[pIdx]).tid_].get();
+				auto vs = (rows[pIdx] ? vios[pIdx] : ios[pIdx])->binSize();
+				fixed = vs == info.typeSize() && (!info.isList() || (rows[pIdx] && rows[pIdx]->arity));
+				srcs[pIdx] = views[pIdx] ? views[pIdx] : static_cast<const char*>(info.rawPtr(*datas[pIdx]));
+				offs[pIdx] = stride;
+				vsiz[pIdx] = vs;
+				stride += rows[pIdx] ? lsiz[pIdx] + rows[pIdx]->arity * vs : vs;
+			}
+			if(fixed && stride)
+			{
+				std::size_t const rowsPerBlock = std::max<std::size_t>(1, (std::size_t(1) << 18) / stride);
+				std::vector<char> block(std::min(rowsPerBlock, size_) * stride);
+				std::vector<const char*> cols(np); // columns of the current block
+				if(offsets)
+					internal::strideOffsets(*offsets, step, size_, stride);
+				for(std::size_t i = 0; i < size_; i += rowsPerBlock)
+				{
+					auto n = std::min(rowsPerBlock, size_ - i);
+					for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+					{
+						auto vs = vsiz[pIdx];
+						auto dst = block.data() + offs[pIdx];
+						auto k = std::size_t(0); // neighbouring plain columns of the same size are gathered together
+						while(pIdx + k < np && !rows[pIdx + k] && vsiz[pIdx + k] == vs)
+						{
+							cols[k] = srcs[pIdx + k] + i * vs;
+							k++;
+						}
+						if(k > 1)
+						{
+							internal::interleave(cols.data(), k, vs, dst, stride, n, swapEndian);
+							pIdx += k - 1;
+						}
+						else if(auto r = rows[pIdx])
+						{
+							char idx[4];
+							internal::listIndex(idx, r->arity, lsiz[pIdx], swapEndian);
+							internal::stridedCopy(idx, 0, dst, stride, n, lsiz[pIdx], false);
+							for(std::size_t j = 0; j < r->arity; j++)
+								internal::stridedCopy(srcs[pIdx] + (i * r->arity + j) * vs, r->arity * vs, dst + lsiz[pIdx] + j * vs, stride, n, vs, swapEndian);
+						}
+						else
+							internal::stridedCopy(srcs[pIdx] + i * vs, vs, dst, stride, n, vs, swapEndian);
+					}
+					out.write(block.data(), static_cast<std::streamsize>(n * stride));
+				}
+				return;
+			}
+			for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+				if(views[pIdx])
+					copy(pIdx);
+
+			// rows of a variable size are packed into a reusable buffer that is written in large blocks
+			std::size_t const blockSize = std::size_t(1) << 20;
+			std::string block;
+			block.reserve(blockSize + 256);
+			std::size_t written = 0; // bytes before the block
+			auto flush = [&block, &out, &written] () {
+				out.write(block.data(), static_cast<std::streamsize>(block.size()));
+				written += block.size();
+				block.clear();
+			};
+			auto pack = [&block, &out, &flush, &written, offsets] (const type * io, const void* ptr, std::size_t i, std::uint8_t lsiz) {
+				if(io->packs())
+					io->pack(block, ptr, i, lsiz, swapEndian);
+				else
+				{
+					flush();
+					auto at = offsets ? out.tellp() : std::streampos(0);
+					io->binO(out, ptr, i, lsiz, swapEndian);
+					if(offsets)
+						written += static_cast<std::size_t>(out.tellp() - at);
+				}
+			};
+			for(std::size_t i = 0; i < size_; i++)
+			{
+				if(offsets && i % step == 0)
+					offsets->push_back(written + block.size());
+				for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+				{
+					if(auto r = rows[pIdx])
+					{
+						auto first = r->first(i);
+						auto n = r->count(i);
+						char idx[4];
+						internal::listIndex(idx, n, lsiz[pIdx], swapEndian);
+						block.append(idx, lsiz[pIdx]);
+						if(vsiz[pIdx] == parent_->info_[properties_.at(order_[pIdx]).tid_]->typeSize())
+						{ // values are plain memory
+							auto vs = vsiz[pIdx];
+							auto at = block.size();
+							block.resize(at + n * vs);
+							internal::stridedCopy(srcs[pIdx] + first * vs, vs, block.data() + at, vs, n, vs, swapEndian);
+						}
+						else
+							for(auto j = first; j < first + n; j++)
+								pack(vios[pIdx], ptrs[pIdx], j, 0);
+					}
+					else
+						pack(ios[pIdx], ptrs[pIdx], i, lsiz[pIdx]);
+				}
+				if(block.size() >= blockSize)
+					flush();
+			}
+			if(offsets)
+				offsets->push_back(written + block.size());
+			flush();
+		}
+		else
+			throw std::runtime_error("Unknown output format");
+	}
+
+	template<format ff, std::endian ee>
+	void elem::read(std::istream & in, std::size_t step, std::vector<std::size_t>* offsets)
+	{
+		if constexpr(ff == format::ascii)
+		{
+			parseRows(dynamic_cast<internal::inbuf&>(*in.rdbuf()), 0);
+			return;
+		}
+		std::size_t np = order_.size();
+		std::vector<const type *> ios(np); // serializer & deserializer for each property
+		std::vector<void*> ptrs(np); // ptr on the vectors (NOT the data)
+		std::vector<std::uint8_t> lsiz(np); // list index type sizes
+		std::vector<internal::flatfill> flat(np); // state of flat property lists (rows == nullptr otherwise)
+		std::vector<const type *> vios(np); // deserializer for the values of flat property lists
+		std::vector<const prop*> fused(np); // converted while decoding (rows of a fixed size only)
+		for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+		{
+			auto & p = properties_[order_[pIdx]];
+			ios[pIdx] = parent_->ios_[p.tid_].get();
+			auto & info = *parent_->info_[p.tid_].get();
+			if(info.isList() && (flat[pIdx].rows = info.rows(p.data_)))
+			{
+				flat[pIdx].info = &info;
+				flat[pIdx].data = &p.data_;
+				vios[pIdx] = parent_->ios_[info.tid()].get();
+			}
+			else if(p.fused_)
+				fused[pIdx] = &p;
+			else if(!p.skip_) // skipped properties keep nullptr
+				ptrs[pIdx] = info.vecPtr(p.data_);
+			lsiz[pIdx] = p.listIndexSize_;
+		}
+		std::size_t start = 0; // first row that is not decoded yet
+		if constexpr(ff == format::binary)
+		{
+			constexpr bool swapEndian = ee != std::endian::native;
+			auto & buf = dynamic_cast<internal::inbuf&>(*in.rdbuf());
+			auto const origin = buf.pos(); // of the first row
+			auto bytes = [&buf, this] (std::size_t n) {
+				auto src = buf.need(n);
+				if(!src)
+					throw std::runtime_error(std::format("unexpected end of file in element \"{}\"", name()));
+				return src;
+			};
+
+			// plain values and lists (flat or nested) with a fixed arity give rows of a fixed size
+			// that can be decoded block by block. the arity is taken from the first row and checked
+			// for all others, at the first row that does not match the decoding continues row by row.
+			// the row size of lists is a guess that may reach past the element, so sources that
+			// cannot seek back decode lists row by row.
+			std::vector<std::size_t> offs(np); // offset of each property inside a row
+			std::vector<std::size_t> vsiz(np); // size of the values
+			std::vector<std::size_t> arity(np); // arity of lists
+			std::size_t stride = 0;
+			bool fixed = size_ > 0;
+			bool lists = false;
+			for(std::size_t pIdx = 0; fixed && pIdx < np; pIdx++)
+			{
+				auto & info = *parent_->info_[properties_[order_[pIdx]].tid_].get();
+				auto vs = (flat[pIdx].rows ? vios[pIdx] : ios[pIdx])->binSize();
+				fixed = vs == info.typeSize() && (!info.isList() || (!buf.exact() && (flat[pIdx].rows || ios[pIdx]->blockLists())));
+				offs[pIdx] = stride;
+				vsiz[pIdx] = vs;
+				if(fixed && info.isList())
+				{ // arity of the first row
+					lists = true;
+					arity[pIdx] = internal::listIndex(bytes(stride + lsiz[pIdx]) + stride, lsiz[pIdx], swapEndian);
+					fixed = arity[pIdx] > 0;
+					stride += lsiz[pIdx] + arity[pIdx] * vs;
+				}
+				else
+					stride += vs;
+			}
+			if(fixed && stride)
+			{
+				std::vector<char*> dsts(np);
+				std::vector<std::array<char, 4>> idxs(np); // encoded arity
+				for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+				{
+					auto & p = properties_[order_[pIdx]];
+					if(auto & f = flat[pIdx]; f.rows)
+					{
+						f.rows->offsets.clear();
+						f.rows->arity = arity[pIdx];
+						f.capacity = size_ * arity[pIdx];
+						f.values = f.info->resize(*f.data, f.capacity);
+						dsts[pIdx] = f.values;
+					}
+					else if(!arity[pIdx] && (ptrs[pIdx] || fused[pIdx]))
+						dsts[pIdx] = static_cast<char*>(parent_->info_[fused[pIdx] ? p.as_ : p.tid_]->rawPtr(p.data_));
+					if(arity[pIdx])
+						internal::listIndex(idxs[pIdx].data(), arity[pIdx], lsiz[pIdx], swapEndian);
+				}
+				std::size_t const rowsPerBlock = std::max<std::size_t>(1, (std::size_t(1) << 18) / stride);
+				while(start < size_)
+				{
+					auto n = std::min(rowsPerBlock, size_ - start);
+					auto src = lists ? buf.need(n * stride) : bytes(n * stride);
+					if(!src)
+					{ // rows with less values at the end of the file?
+						n = buf.available() / stride;
+						src = buf.need(n * stride);
+						if(!n)
+							break;
+					}
+					auto m = n; // rows that match the arity
+					for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+						if(arity[pIdx])
+							m = std::min(m, internal::mismatch(src + offs[pIdx], stride, n, idxs[pIdx].data(), lsiz[pIdx]));
+					if(offsets)
+						for(auto i = (start + step - 1) / step * step; i < start + m; i += step)
+							offsets->push_back(buf.pos() - origin + (i - start) * stride);
+					for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+					{
+						auto vs = vsiz[pIdx];
+						if(auto k = arity[pIdx]; k && dsts[pIdx])
+						{
+							for(std::size_t j = 0; j < k; j++)
+								internal::stridedCopy(src + offs[pIdx] + lsiz[pIdx] + j * vs, stride, dsts[pIdx] + (start * k + j) * vs, k * vs, m, vs, swapEndian);
+						}
+						else if(k && ptrs[pIdx])
+							ios[pIdx]->binRows(src + offs[pIdx] + lsiz[pIdx], stride, ptrs[pIdx], start, m, k, swapEndian);
+						else if(auto q = fused[pIdx])
+						{
+							auto ts = parent_->info_[q->as_]->typeSize();
+							internal::convert(q->tid_, src + offs[pIdx], stride, q->as_, dsts[pIdx] + start * ts, m, swapEndian);
+						}
+						else if(dsts[pIdx])
+							internal::stridedCopy(src + offs[pIdx], stride, dsts[pIdx] + start * vs, vs, m, vs, swapEndian);
+					}
+					buf.skip(m * stride);
+					start += m;
+					if(m < n)
+						break;
+				}
+				for(auto & f : flat)
+					if(f.rows && start < size_)
+						f.unfix(start, size_);
+			}
+
+			for(std::size_t i = start; i < size_; i++)
+			{
+				if(offsets && i % step == 0)
+					offsets->push_back(buf.pos() - origin);
+				for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+				{
+					if(auto & f = flat[pIdx]; f.rows)
+					{
+						auto n = internal::listIndex(bytes(lsiz[pIdx]), lsiz[pIdx], swapEndian);
+						buf.skip(lsiz[pIdx]);
+						auto dst = f.next(i, n);
+						auto vs = vios[pIdx]->binSize();
+						if(vs && vs == f.info->typeSize())
+						{ // values are plain memory
+							internal::stridedCopy(bytes(n * vs), vs, dst, vs, n, vs, swapEndian);
+							buf.skip(n * vs);
+						}
+						else
+						{
+							auto values = f.info->values(*f.data);
+							for(auto j = f.rows->offsets[i]; j < f.rows->offsets[i + 1]; j++)
+								vios[pIdx]->binI(in, values, j, 0, swapEndian);
+						}
+					}
+					else if(ptrs[pIdx])
+						ios[pIdx]->binI(in, ptrs[pIdx], i, lsiz[pIdx], swapEndian);
+					else
+					{ // skipped, plain values are not decoded
+						std::size_t n = 1;
+						if(lsiz[pIdx])
+						{
+							n = internal::listIndex(bytes(lsiz[pIdx]), lsiz[pIdx], swapEndian);
+							buf.skip(lsiz[pIdx]);
+						}
+						n *= ios[pIdx]->binSize();
+						bytes(n);
+						buf.skip(n);
+					}
+				}
+			}
+			if(offsets)
+				offsets->push_back(buf.pos() - origin);
+		}
+		for(auto & f : flat)
+			if(f.rows)
+				f.finish(size_);
+	}
+
+	void elem::readRows(const char* src, std::size_t first, std::size_t last, bool swapEndian) const
+	{
+		auto stride = parent_->stride(*this);
+		std::size_t offset = 0; // of the property inside a row
+		for(auto & pn : order_)
+		{
+			auto & p = properties_.at(pn);
+			auto & info = *parent_->info_.at(p.tid_);
+			auto size = info.typeSize();
+			if(p.fused_)
+			{
+				auto & to = *parent_->info_.at(p.as_);
+				auto dst = static_cast<char*>(to.rawPtr(const_cast<std::any&>(p.data_)));
+				internal::convert(p.tid_, src + offset, stride, p.as_, dst + first * to.typeSize(), last - first, swapEndian);
+			}
+			else if(!p.skip_)
+			{ // every row is written by exactly one task
+				auto dst = static_cast<char*>(info.rawPtr(const_cast<std::any&>(p.data_)));
+				internal::stridedCopy(src + offset, stride, dst + first * size, size, last - first, size, swapEndian);
+			}
+			offset += size;
+		}
+	}
+
+	void elem::readLines(std::string_view body, const std::size_t* lines, std::size_t first, std::size_t last, std::vector<std::any> & locals) const
+	{
+		std::size_t np = order_.size();
+		std::vector<const type *> ios(np); // deserializer for each property
+		std::vector<void*> ptrs(np); // ptr on the vectors (NOT the data)
+		std::vector<internal::flatfill> flat(np); // state of flat property lists (rows == nullptr otherwise)
+		std::vector<const type *> vios(np); // deserializer for the values of flat property lists
+		for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+		{
+			auto & p = properties_.at(order_[pIdx]);
+			auto & info = *parent_->info_[p.tid_].get();
+			ios[pIdx] = parent_->ios_[p.tid_].get();
+			if(info.isList() && info.rows(p.data_))
+			{
+				flat[pIdx] = {&info, &locals[pIdx], info.rows(locals[pIdx])};
+				vios[pIdx] = parent_->ios_[info.tid()].get();
+			}
+			else if(p.skip_) // skipped lists are marked by the deserializer for their values
+				vios[pIdx] = info.isList() ? parent_->ios_[info.tid()].get() : nullptr;
+			else // every row is written by exactly one thread
+				ptrs[pIdx] = info.vecPtr(const_cast<std::any&>(p.data_));
+		}
+		for(std::size_t i = first; i < last; i++)
+		{
+			auto end = body.data() + lines[i + 1];
+			const char* cur;
+			try
+			{
+				cur = parseRow(body.data() + lines[i], end, i, i - first, ios, vios, ptrs, flat);
+			}
+			catch(internal::truncated &)
+			{ // the row continues on the next line
+				cur = nullptr;
+			}
+			if(!cur || internal::skipSpace(cur, end) != end)
+				throw internal::misaligned(std::format("line does not match row {} of element \"{}\"", i, name()));
+		}
+	}
+
+	void elem::parseRows(internal::inbuf & buf, std::size_t first)
+	{
+		std::size_t np = order_.size();
+		std::vector<const type *> ios(np); // deserializer for each property
+		std::vector<void*> ptrs(np); // ptr on the vectors (NOT the data)
+		std::vector<internal::flatfill> flat(np); // state of flat property lists (rows == nullptr otherwise)
+		std::vector<const type *> vios(np); // deserializer for the values of flat property lists
+		for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+		{
+			auto & p = properties_[order_[pIdx]];
+			auto & info = *parent_->info_[p.tid_].get();
+			ios[pIdx] = parent_->ios_[p.tid_].get();
+			if(info.isList() && (flat[pIdx].rows = info.rows(p.data_)))
+			{
+				flat[pIdx].info = &info;
+				flat[pIdx].data = &p.data_;
+				vios[pIdx] = parent_->ios_[info.tid()].get();
+			}
+			else if(p.skip_) // skipped lists are marked by the deserializer for their values
+				vios[pIdx] = info.isList() ? parent_->ios_[info.tid()].get() : nullptr;
+			else
+				ptrs[pIdx] = info.vecPtr(p.data_);
+		}
+
+		// rows are parsed in place from a window of complete lines that is refilled when it runs low
+		std::size_t window = std::size_t(1) << 20;
+		const char* cur = buf.first();
+		const char* end = cur;
+		bool eof = false;
+		auto refill = [&] () {
+			buf.skip(static_cast<std::size_t>(cur - buf.first()));
+			auto n = buf.lines(window);
+			eof = buf.available() < window;
+			cur = buf.first();
+			end = cur + n;
+		};
+		if(first < size_)
+			refill();
+		for(std::size_t i = first; i < size_;)
+		{
+			try
+			{
+				cur = parseRow(cur, end, i, i, ios, vios, ptrs, flat);
+				i++;
+				if(!eof && static_cast<std::size_t>(end - cur) < window / 16)
+					refill();
+			}
+			catch(internal::truncated &)
+			{ // the row continues after the complete lines
+				if(eof)
+					throw;
+				if(static_cast<std::size_t>(buf.last() - cur) >= window)
+					window *= 2;
+				refill();
+			}
+		}
+		buf.skip(static_cast<std::size_t>(cur - buf.first()));
+		for(auto & f : flat)
+			if(f.rows)
+				f.finish(size_);
+	}
+
+	const char* elem::parseRow(const char* cur, const char* last, std::size_t i, std::size_t fi, const std::vector<const type *> & ios, const std::vector<const type *> & vios, const std::vector<void*> & ptrs, std::vector<internal::flatfill> & flat) const
+	{
+		auto parse = [&cur, last] (const type * io, void* ptr, std::size_t j) {
+			if(io->chars())
+				cur = io->parse(cur, last, ptr, j);
+			else
+			{ // stream based fallback for custom types
+				cur = internal::skipSpace(cur, last);
+				internal::inbuf buf(cur, static_cast<std::size_t>(last - cur));
+				std::istream in(&buf);
+				io->ascI(in, ptr, j);
+				if(in.fail())
+				{
+					if(!buf.available())
+						throw internal::truncated();
+					throw std::runtime_error("cannot parse ascii value");
+				}
+				cur = buf.first();
+			}
+		};
+		for(std::size_t pIdx = 0; pIdx < ios.size(); pIdx++)
+		{
+			if(auto & f = flat[pIdx]; f.rows)
+			{
+				std::int64_t n = 0;
+				cur = internal::fromChars(cur, last, n);
+				if(n < 0)
+					throw std::runtime_error("Negative size for property list");
+				f.next(fi, static_cast<std::size_t>(n));
+				auto values = f.info->values(*f.data);
+				for(auto j = f.rows->offsets[fi]; j < f.rows->offsets[fi + 1]; j++)
+					parse(vios[pIdx], values, j);
+			}
+			else if(ptrs[pIdx])
+				parse(ios[pIdx], ptrs[pIdx], i);
+			else
+			{ // skipped, the values are not parsed
+				std::int64_t n = 1;
+				if(vios[pIdx])
+					cur = internal::fromChars(cur, last, n);
+				for(std::int64_t j = 0; j < n; j++)
+					cur = internal::skipToken(cur, last);
+			}
+		}
+		return cur;
+	}
+
+	// ---------------------------------------------------------------
+	// Root
+	// ---------------------------------------------------------------
+
+	bool root::has(std::string_view en) const
+	{
+		return elements_.contains(std::string(en));
+	}
+
+	bool root::has(std::string_view en, std::string_view pn) const
+	{
+		if(!elements_.contains(std::string(en)))
+			return false;
+		return elements_.at(std::string(en)).has(pn);
+	}
+
+	void root::del(std::string_view n)
+	{
+		auto it = elements_.find(std::string(n));
+		if(it == elements_.end())
+			throw std::runtime_error(std::format("cannot delete something that does not exist root.{}", n));
+		for(auto & [pn, p] : it->second.properties_)
+			drop(p);
+		names_.erase(&it->second);
+		elements_.erase(std::string(n));
+		for(std::size_t i = 0; i < order_.size(); i++)
+		{
+			if(order_[i] == n)
+			{
+				order_.erase(order_.begin() + i);
+				break;
+			}
+		}
+	}
+
+	std::vector<std::reference_wrapper<elem>> root::elements()
+	{
+		std::vector<std::reference_wrapper<elem>> info;
+		for(auto & [n, e] : elements_)
+			info.emplace_back(e);
+		return info;
+	}
+
+	std::vector<std::string> root::names() const
+	{
+		std::vector<std::string> info;
+		for(auto & [n, e] : elements_)
+			info.emplace_back(e.name());
+		return info;
+	}
+
+	char root::lineSeperator(char newLinesep)
+	{
+		std::swap(linesep_, newLinesep);
+		return newLinesep;
+	}
+
+	bool root::flatLists(bool newFlat)
+	{
+		std::swap(flat_, newFlat);
+		return newFlat;
+	}
+
+	unsigned root::threads(unsigned newThreads)
+	{
+		std::swap(threads_, newThreads);
+		return newThreads;
+	}
+
+	bool root::prefetch(bool newPrefetch)
+	{
+		std::swap(prefetch_, newPrefetch);
+		return newPrefetch;
+	}
 
-		template<
-            format ff = format::ascii,
-            std::endian ee = std::endian::native>
-		void write(std::ostream &) const;
+	bool root::shortestFloats(bool newShortest)
+	{
+		std::swap(shortest_, newShortest);
+		return newShortest;
+	}
 
-		std::unordered_map<
-            const prop*,
-            std::string>            names_;
-		std::vector<std::string>    order_;
-		root*                       parent_ = nullptr;
+	std::function<void(const event&)> root::instrument(std::function<void(const event&)> newSink)
+	{
+		std::swap(sink_, newSink);
+		return newSink;
+	}
 
-		std::unordered_map<
-            std::string,
-            prop>                   properties_;
+	void root::report(event::phase what, std::string_view name, std::chrono::steady_clock::time_point start, std::size_t bytes, std::size_t rows, std::size_t allocations) const
+	{
+		sink_({what, name, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), bytes, rows, allocations});
+	}
 
-		std::size_t                 size_ = 0;
-	};
+	std::unordered_map<std::string, std::type_index> root::convert(std::unordered_map<std::string, std::type_index> newConvert)
+	{
+		std::swap(convert_, newConvert);
+		return newConvert;
+	}
 
-	struct root
+	std::vector<std::string> root::select(std::vector<std::string> newSelect)
 	{
-		friend elem;
-		friend prop;
+		std::swap(select_, newSelect);
+		return newSelect;
+	}
 
-		root();
+	std::size_t root::indexRows(std::size_t newStep)
+	{
+		std::swap(indexStep_, newStep);
+		return newStep;
+	}
 
-        // full init
-		elem& operator()(
-            std::string_view,
-            std::size_t);
-        // access only after init
-		elem& operator()(
-            std::string_view);
-        // const access
-		const elem& operator()(
-            std::string_view) const;
+	const rowindex & root::index() const
+	{
+		return index_;
+	}
 
-        // get all the comments and manage them yourself
-		std::vector<std::string>& comments();
+	bool root::selected(std::string_view en, std::string_view pn) const
+	{
+		for(auto & s : select_)
+			if(s == en || (s.size() == en.size() + 1 + pn.size() && s.starts_with(en) && s[en.size()] == '.' && s.ends_with(pn)))
+				return true;
+		return false;
+	}
 
-        // load a file (do not forget std::ios::binary!)
-		void read(
-            std::istream&);
-        // load a file
-		void read(
-            const std::string&);
-        
-        // add a custom datatype
-		template<
-            typename T,
-            template<typename, bool> typename CustomIO>
-        void registerType();
-		
-        // write a file to utput stream
-        template<
-            format ff = format::ascii,
-            std::endian ee = std::endian::native>
-		void write(
-            std::ostream &) const;
+	void root::project()
+	{
+		if(select_.empty())
+			return;
+		std::size_t last = 0;
+		for(std::size_t i = 0; i < order_.size(); i++)
+		{
+			auto & e = elements_[order_[i]];
+			for(auto & pn : e.order_)
+			{
+				auto & p = e.properties_[pn];
+				auto & io = *ios_[p.tid_].get();
+				if(selected(e.name(), pn))
+					last = i + 1;
+				else // values that cannot be skipped are decoded and deleted later
+					p.skip_ = io.binSize() && io.chars();
+			}
+			if(e.order_.empty() && selected(e.name(), {}))
+				last = i + 1;
+		}
+		while(order_.size() > last)
+			del(order_.back());
+	}
 
-        // write a file
-		template<
-            format ff = format::ascii,
-            std::endian ee = std::endian::native>
-        void write(
-            const std::string&) const;
-		
-        // get ascii representation of the ply
-        std::string str() const;
-		
-        // old line seperator = lineSeperator(new line seperator)
-        char lineSeperator(char);
-		
-        // get all the elements
-        std::vector<std::reference_wrapper<elem>> elements();
-		
-        // get all element names
-        std::vector<std::string> names() const;
-		
-        // delete an element by name
-        void del(std::string_view);
-		
-        // check if element exists
-        bool has(std::string_view) const;
-		
-        // check if element with property exists
-        bool has(
-            std::string_view,
-            std::string_view) const;
+	void root::prune()
+	{
+		if(select_.empty())
+			return;
+		for(auto en : std::vector<std::string>(order_))
+		{
+			auto & e = elements_[en];
+			for(auto pn : std::vector<std::string>(e.order_))
+				if(!selected(en, pn))
+					e.del(pn);
+			if(e.order_.empty() && !selected(en, {}))
+				del(en);
+		}
+	}
 
-	private:
-		std::type_index typeidFromStr(
-            std::string_view,
-            bool);
-		
-        char linesep_ = str::lf;
+	void root::allocate(elem & e)
+	{
+		for(auto & pn : e.order_)
+		{
+			auto & p = e.properties_[pn];
+			auto tid = p.fused_ ? p.as_ : p.tid_; // the column has the converted type
+			auto & info = *info_[tid].get();
+			if(p.skip_)
+				continue;
+			auto start = sink_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+			bool flat = flat_ && info.isList();
+			bool kept = false;
+			if(pool_)
+			{ // reuse a column of the same kind
+				std::unique_lock lock(pool_->mutex_);
+				auto & columns = (flat ? pool_->flat_ : pool_->columns_)[tid];
+				if(!columns.empty())
+				{
+					p.data_ = std::move(columns.back().data);
+					pool_->bytes_ -= columns.back().bytes;
+					columns.pop_back();
+					lock.unlock();
+					info.reshape(p.data_, e.size_);
+					kept = true;
+				}
+			}
+			if(!kept)
+				p.data_ = flat ? info.flat(e.size_) : anyvec_[tid](e.size_);
+			if(sink_)
+				report(event::phase::allocate, std::format("{}.{}", e.name(), pn), start, info.isList() ? 0 : info.typeSize() * e.size_, e.size_, kept ? 0 : 1);
+		}
+	}
 
-        std::unordered_map<
-            std::type_index,
-            std::function<
-                std::any(std::size_t)>>     anyvec_;
-		std::vector<std::string>            comments_;
-		std::unordered_map<
-            std::string,
-            elem>                           elements_;
-		std::unordered_map<
-            std::type_index,
-            std::unique_ptr<
-                internal::ErasedInfoBase>>  info_;
-		std::unordered_map<
-            std::type_index,
-            std::unique_ptr<type>>          ios_;
-		std::unordered_map<
-            const elem*,
-            std::string>                    names_;
-		std::vector<std::string>            order_;		
-	};
+	void root::retype(format fmt)
+	{
+		for(auto & [name, to] : convert_)
+		{
+			auto dot = name.find('.');
+			if(dot == std::string::npos || !has(name.substr(0, dot), name.substr(dot + 1)))
+				continue;
+			auto & e = elements_[name.substr(0, dot)];
+			auto & p = e.properties_[name.substr(dot + 1)];
+			if(p.skip_ || p.tid_ == to)
+				continue;
+			if(!internal::number(p.tid_, [] (auto*) {}) || !internal::number(to, [] (auto*) {}))
+				throw std::runtime_error(std::format("cannot convert property \"{}\" from \"{}\" to \"{}\"", name, p.tid_.name(), to.name()));
+			p.as_ = to;
+			p.fused_ = fmt == format::binary && stride(e);
+		}
+	}
 
-	// ---------------------------------------------------------------
-	// Property
-	// ---------------------------------------------------------------
+	void root::settle()
+	{
+		for(auto & [en, e] : elements_)
+			for(auto & [pn, p] : e.properties_)
+			{
+				if(p.as_ == typeid(void))
+					continue;
+				if(p.fused_)
+					p.tid_ = p.as_;
+				else
+					p.convert(p.as_);
+				p.as_ = typeid(void);
+				p.fused_ = false;
+			}
+	}
+
+	void root::drop(prop & p)
+	{
+		if(!pool_ || !p.data_.has_value())
+			return;
+		auto tid = p.fused_ ? p.as_ : p.tid_;
+		bool flat = info_[tid]->rows(p.data_) != nullptr;
+		auto bytes = info_[tid]->bytes(p.data_);
+		std::vector<std::any> released;
+		{
+			std::lock_guard lock(pool_->mutex_);
+			if(bytes <= pool_->limit_)
+			{
+				(flat ? pool_->flat_ : pool_->columns_)[tid].push_back({std::move(p.data_), bytes, pool_->serial_++});
+				pool_->bytes_ += bytes;
+				released = pool_->trim();
+			}
+		}
+		p.data_.reset();
+	}
+
+	std::shared_ptr<pool> root::recycle(std::shared_ptr<pool> newPool)
+	{
+		std::swap(pool_, newPool);
+		return newPool;
+	}
+
+	void pool::clear()
+	{
+		std::lock_guard lock(mutex_);
+		columns_.clear();
+		flat_.clear();
+		bytes_ = 0;
+	}
+
+	std::size_t pool::bytes() const
+	{
+		std::lock_guard lock(mutex_);
+		return bytes_;
+	}
+
+	std::size_t pool::limit(std::size_t newLimit)
+	{
+		std::vector<std::any> released;
+		std::lock_guard lock(mutex_);
+		std::swap(limit_, newLimit);
+		released = trim();
+		return newLimit;
+	}
+
+	std::vector<std::any> pool::trim()
+	{
+		std::vector<std::any> released;
+		while(bytes_ > limit_)
+		{
+			std::deque<kept>* oldest = nullptr;
+			for(auto kinds : {&columns_, &flat_})
+				for(auto & [tid, columns] : *kinds)
+					if(!columns.empty() && (!oldest || columns.front().serial < oldest->front().serial))
+						oldest = &columns;
+			bytes_ -= oldest->front().bytes;
+			released.push_back(std::move(oldest->front().data));
+			oldest->pop_front();
+		}
+		return released;
+	}
+
+	std::size_t pool::size() const
+	{
+		std::lock_guard lock(mutex_);
+		std::size_t n = 0;
+		for(auto & [tid, kept] : columns_)
+			n += kept.size();
+		for(auto & [tid, kept] : flat_)
+			n += kept.size();
+		return n;
+	}
+
+	std::vector<std::string> & root::comments()
+	{
+		return comments_;
+	}
+	elem & root::operator()(std::string_view name, std::size_t size)
+	{
+		auto [it, inserted] = elements_.try_emplace(std::string(name));
+		if(inserted)
+		{
+			order_.push_back(std::string(name));
+			names_[&it->second] = std::string(name);
+			it->second.size_ = size;
+			it->second.parent_ = this;
+		}
+		return it->second;
+	}
+	elem & root::operator()(std::string_view name)
+	{
+		if(!elements_.contains(std::string(name)))
+			throw std::runtime_error("cannot access non initialized element");
+		// this could be partial initialization without size, but then the size needs to come from "somewhere"...
+		return elements_[std::string(name)];
+	}
+	elem const & root::operator()(std::string_view name) const
+	{
+		if(!elements_.contains(std::string(name)))
+			throw std::runtime_error("cannot access non initialized element");
+		// this could be partial initialization without size, but then the size needs to come from "somewhere"...
+		return elements_.at(std::string(name));
+	}
+
+	template<typename T, template<typename, bool> typename CustomIO> void root::registerType()
+	{
+		ios_.insert({typeid(T),std::make_unique<CustomIO<T, false>>()});
+		info_.insert({typeid(T),std::make_unique<internal::ErasedInfo<T, false>>()});
+		anyvec_.insert({typeid(T), [] (std::size_t s) { return std::vector<T>(s); }});
+		ios_.insert({typeid(std::vector<T>),std::make_unique<CustomIO<T, true>>()});
+		info_.insert({typeid(std::vector<T>),std::make_unique<internal::ErasedInfo<T, true>>()});
+		anyvec_.insert({typeid(std::vector<T>), [] (std::size_t s) { return std::vector<std::vector<T>>(s); }});
+	}
+
+	std::type_index root::typeidFromStr(std::string_view s, bool isList)
+	{
+		for(auto const & [tid, ios] : ios_)
+		{
+			if(info_[tid]->isList())
+				continue; // list and non list share the same names
+			for(auto & sw : ios->names())
+				if(sw == s) return isList ? info_[tid]->vecTid() : tid;
+		}
+		return typeid(void);
+	}
+
+	void root::read(std::string const & path)
+	{
+		std::ifstream in(path, std::ios::binary | std::ios::in);
+		if(!in.good())
+			throw std::runtime_error(std::format("cannot open file in read mode: \"{}\"", path));
+		read(in);
+	}
+
+	void root::read(std::istream & in)
+	{
+		auto [fmt, endian] = readHeader(in);
+		project();
+		retype(fmt);
+		for(auto & en : order_)
+			allocate(elements_[en]);
+		readBody(in, fmt, endian);
+		settle();
+		prune();
+	}
+
+	void root::reload(std::string const & path)
+	{
+		std::ifstream in(path, std::ios::binary | std::ios::in);
+		if(!in.good())
+			throw std::runtime_error(std::format("cannot open file in read mode: \"{}\"", path));
+		reload(in);
+	}
+
+	void root::reload(std::istream & in)
+	{
+		if(!select_.empty())
+			throw std::runtime_error("reload does not support a selection");
+		if(!convert_.empty())
+			throw std::runtime_error("reload does not support conversions");
+		auto [fmt, endian] = readHeader(in, true);
+		for(auto & en : order_)
+		{
+			auto & e = elements_[en];
+			for(auto & pn : e.order_)
+			{ // the decoders overwrite every row
+				auto & p = e.properties_[pn];
+				if(p.data_.has_value())
+					info_[p.tid_]->reshape(p.data_, e.size_);
+				else
+					p.data_ = flat_ && info_[p.tid_]->isList() ? info_[p.tid_]->flat(e.size_) : anyvec_[p.tid_](e.size_);
+				p.view_ = nullptr;
+			}
+		}
+		map_.reset();
+		readBody(in, fmt, endian);
+	}
+
+	void root::map(std::string const & path)
+	{
+		auto fm = std::make_shared<internal::filemap>(path);
+		internal::inbuf buf(fm->data(), fm->size());
+		std::istream in(&buf);
+		auto [fmt, endian] = readHeader(in);
+		project();
+		retype(fmt);
+		if(fmt == format::ascii || endian != std::endian::native)
+		{ // nothing to map, decode everything
+			for(auto & en : order_)
+				allocate(elements_[en]);
+			readBody(in, fmt, endian);
+			settle();
+			prune();
+			return;
+		}
+		std::size_t const body = buf.pos();
+		std::size_t offset = body;
+		index_ = {indexStep_, {}};
+		for(auto & en : order_)
+		{
+			auto & e = elements_[en];
+			std::size_t stride = this->stride(e);
+			auto offsets = indexStep_ ? &index_.offsets[en] : nullptr;
+			if(stride || e.order_.empty())
+			{ // fixed row size, the properties point into the mapping
+				if(offset + stride * e.size_ > fm->size())
+					throw std::runtime_error(std::format("file is too short for element \"{}\"", en));
+				if(offsets)
+				{
+					auto base = offset - body;
+					internal::strideOffsets(*offsets, indexStep_, e.size_, stride);
+					internal::rebase(*offsets, base);
+				}
+				std::size_t propOffset = 0;
+				for(auto & pn : e.order_)
+				{
+					auto & p = e.properties_[pn];
+					p.view_ = fm->data() + offset + propOffset;
+					p.stride_ = stride;
+					p.fused_ = false; // converted straight out of the mapping by settle
+					propOffset += info_[p.tid_]->typeSize();
+				}
+				offset += stride * e.size_;
+			}
+			else
+			{ // rows with lists have a variable size, decode them
+				allocate(e);
+				buf.pos(offset);
+				auto start = sink_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+				e.read<format::binary, std::endian::native>(in, indexStep_, offsets);
+				if(sink_)
+					report(event::phase::decode, en, start, buf.pos() - offset, e.size_);
+				if(!in.good())
+					throw std::runtime_error(std::format("file is too short for element \"{}\"", en));
+				if(offsets)
+				{
+					auto base = offset - body;
+					internal::rebase(*offsets, base);
+				}
+				offset = buf.pos();
+			}
+		}
+		map_ = std::move(fm);
+		settle();
+		prune();
+	}
 
-	std::vector<std::reference_wrapper<prop>> elem::properties()
+	layout root::probe(std::string const & path)
 	{
-		std::vector<std::reference_wrapper<prop>> info;
-		for(auto & [n, p] : properties_)
-			info.emplace_back(p);
-		return info;
+		std::ifstream in(path, std::ios::binary | std::ios::in);
+		if(!in.good())
+			throw std::runtime_error(std::format("cannot open file in read mode: \"{}\"", path));
+		return probe(in);
 	}
 
-	std::vector<std::string> elem::names() const
+	layout root::probe(std::istream & in)
 	{
-		std::vector<std::string> info;
-		for(auto & [n, p] : properties_)
-			info.emplace_back(p.name());
-		return info;
+		auto start = in.tellg();
+		layout l;
+		std::tie(l.fmt, l.endian) = readHeader(in);
+		auto end = in.tellg();
+		if(start == std::streampos(-1) || end == std::streampos(-1))
+			throw std::runtime_error("cannot probe a stream without position");
+		l.body = static_cast<std::size_t>(end - start);
+		std::size_t offset = l.fmt == format::binary ? l.body : 0;
+		for(auto & en : order_)
+		{
+			auto & e = elements_[en];
+			auto & le = l.elements.emplace_back(en, e.size_);
+			if(!offset)
+				continue;
+			le.offset = offset;
+			le.stride = stride(e);
+			offset = le.stride || e.order_.empty() ? offset + le.stride * e.size_ : 0;
+		}
+		return l;
 	}
 
-	void* prop::rawPtr()
+	std::size_t root::stride(elem const & e) const
 	{
-		auto & info = *parent_->parent_->info_[tid_].get();
-		return info.rawPtr(data_);
+		std::size_t stride = 0;
+		for(auto & pn : e.order_)
+		{
+			auto & tid = e.properties_.at(pn).tid_;
+			auto & info = *info_.at(tid);
+			if(info.isList() || ios_.at(tid)->binSize() != info.typeSize())
+				return 0;
+			stride += info.typeSize();
+		}
+		return stride;
 	}
 
-	std::size_t prop::rawSize()
+	std::pair<format, std::endian> root::readHeader(std::istream & in, bool keep)
 	{
-		auto & info = *parent_->parent_->info_[tid_].get();
-		return info.typeSize() * size();
+		auto start = sink_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+		auto at = sink_ ? internal::position(in) : 0;
+		if(!keep)
+		{
+			for(auto & [en, e] : elements_)
+				for(auto & [pn, p] : e.properties_)
+					drop(p);
+			elements_.clear();
+			names_.clear();
+			order_.clear();
+			map_.reset();
+		}
+		std::size_t eIdx = 0; // elements of the header so far
+		std::size_t pIdx = 0; // properties of the last element so far
+		std::vector<std::size_t> sizes; // of the existing elements, set after the whole header matches
+		std::vector<std::pair<prop*, std::uint8_t>> listIndexSizes; // of the list properties, set with sizes
+		std::vector<std::string> comments;
+		std::string line;
+		std::size_t lIdx = 0;
+		std::uint32_t crlfCounter = 0;
+		char lastDecodedChar;
+		format fmt = format::ascii;
+		std::endian endian = std::endian::native;
+		elem * lastElement = nullptr;
+		auto property = [&] (std::string_view name, std::type_index const & tid) -> prop & {
+			if(!keep)
+				return lastElement->declare(name, tid);
+			if(pIdx == lastElement->order_.size() || lastElement->order_[pIdx] != name || lastElement->properties_[lastElement->order_[pIdx]].tid_ != tid)
+				throw std::runtime_error(std::format("read line {}: property \"{}\" does not match the existing one", lIdx, name));
+			return lastElement->properties_[lastElement->order_[pIdx++]];
+		};
+		auto complete = [&] () { // all properties of the last element are in the header
+			if(keep && lastElement && pIdx != lastElement->order_.size())
+				throw std::runtime_error(std::format("read line {}: element \"{}\" has less properties than the existing one", lIdx, lastElement->name()));
+		};
+		while(true)
+		{
+			crlfCounter += internal::getline(in, line, lastDecodedChar);
+			if(!line.size() || line == str::end_header)
+				break;
+			if(lIdx == 0)
+			{
+				if(!line.starts_with(str::ply))
+					throw std::runtime_error(std::format("read line {}: wrong magic number in ply file", lIdx + 1));
+			}
+			else if(lIdx == 1)
+			{
+				auto a = internal::split(line, str::space);
+				if(a.size() < 3 || a[0] != str::format)
+					throw std::runtime_error(std::format("read line {}: invalid", lIdx));
+				if(a[1] == str::ascii)
+					fmt = format::ascii;
+				else if(a[1] == str::binary_big_endian)
+				{
+					fmt = format::binary;
+					endian = std::endian::big;
+				}
+				else if(a[1] == str::binary_little_endian)
+				{
+					fmt = format::binary;
+					endian = std::endian::little;
+				}
+				else
+					throw std::runtime_error(std::format("read line {}: invalid", lIdx));
+				if(a[2] != str::version)
+					throw std::runtime_error(std::format("read line {}: invalid version. Only 1.0 is supported", lIdx));
+			}
+			else
+			{
+				auto a = internal::split(line, str::space);
+				switch(line[0])
+				{
+				case 'c':
+				{ // comment ...
+					if(a[0] != str::comment)
+						throw std::runtime_error(std::format("read line {}: invalid", lIdx));
+					comments.push_back(line.substr(a[0].size() + 1));
+				} break;
+				case 'e':
+				{ // element name size
+					if(a[0] != str::elem)
+						throw std::runtime_error(std::format("read line {}: invalid", lIdx));
+					complete();
+					if(!keep)
+						lastElement = &this->operator()(a[1], std::stoi(a[2]));
+					else if(eIdx < order_.size() && order_[eIdx] == a[1])
+					{
+						lastElement = &elements_[order_[eIdx]];
+						sizes.push_back(std::stoi(a[2]));
+					}
+					else
+						throw std::runtime_error(std::format("read line {}: element \"{}\" does not match the existing one", lIdx, a[1]));
+					eIdx++;
+					pIdx = 0;
+				} break;
+				case 'p':
+				{ // property
+					if(a[0] != str::prop)
+						throw std::runtime_error(std::format("read line {}: invalid", lIdx));
+					if(a[1] == str::list)
+					{ // property list type type name
+						auto & p = property(a[4], typeidFromStr(a[3], true));
+						auto listTid = typeidFromStr(a[2], false);
+						if(listTid != typeid(std::uint8_t) && listTid != typeid(std::uint16_t) && listTid != typeid(std::uint32_t))
+							throw std::runtime_error(std::format("read line {}: invalid property list index type", lIdx));
+						listIndexSizes.emplace_back(&p,
+							listTid == typeid(std::uint8_t) ? 1 : listTid == typeid(std::uint16_t) ? 2 : 4);
+					}
+					else
+					{ // property type name
+						property(a[2], typeidFromStr(a[1], false));
+					}
+				} break;
+				default:
+				{
+					// warning might be sufficient, just ignore the line?
+					throw std::runtime_error(std::format("read line {}: invalid", lIdx));
+				}
+				}
+			}
+			lIdx++;
+		}
+		complete();
+		if(keep && eIdx != order_.size())
+			throw std::runtime_error("header has less elements than the existing ones");
+		for(std::size_t i = 0; i < sizes.size(); i++)
+			elements_[order_[i]].size_ = sizes[i];
+		for(auto [p, size] : listIndexSizes)
+			p->listIndexSize_ = size;
+		comments_ = std::move(comments);
+#ifdef USE_CRLF_LFCR_HEADER_HACK
+		auto crlfa = *reinterpret_cast<std::array<std::uint16_t, 2>*>(&crlfCounter);
+		// Problem: per definition "end_header\r" is the end of the header, but many implementations also
+		// use "end_header\n" or "end_header\r\n" or any amount of \n and \r in any sequence. Why? Noone knows.
+		// we expect that there are (avgNSep - 1) seperators after "end_header" left in the stream because one of them was already consumed via getline
+		// we expect that all the seperators \n and \r are used without any other characters inbetween
+		int avgNSep = static_cast<int>(std::lround((static_cast<float>(crlfa[0]) + static_cast<float>(crlfa[1]) - 1) / lIdx));
+		// if avgNSep is no integer -> inconsistent number of linesep per line
+		for(int i = 1; i < avgNSep; i++)
+		{
+			if((lastDecodedChar == str::cr || lastDecodedChar == str::lf) && (in.peek() == str::cr || in.peek() == str::lf))
+				in.get(lastDecodedChar);
+			else
+				throw std::runtime_error("inconsistent line seperators in header");
+		}
+#endif
+		if(sink_)
+			report(event::phase::header, {}, start, internal::position(in) - at, 0);
+		return {fmt, endian};
 	}
 
-	std::size_t prop::size() const
+	void root::readRows(internal::inbuf & buf, unsigned threads, std::size_t first, std::size_t last, bool swapEndian)
 	{
-		return parent_->size_;
+		struct task
+		{
+			const elem* e;
+			std::size_t first;
+			std::size_t last;
+			std::size_t offset; // of row first inside the block
+		};
+		std::size_t const blockSize = std::size_t(threads) << 22;
+		std::size_t const taskSize = std::size_t(1) << 20;
+		std::vector<task> tasks;
+		std::size_t row = 0; // first row of element first that is not decoded yet
+		while(first < last)
+		{
+			tasks.clear();
+			std::size_t bytes = 0;
+			while(first < last && bytes < blockSize)
+			{ // rows of the next elements up to the block size
+				auto & e = elements_[order_[first]];
+				auto stride = this->stride(e);
+				auto n = e.size_ - row;
+				if(stride)
+				{
+					n = std::min(n, std::max<std::size_t>(1, (blockSize - bytes) / stride));
+					auto rows = std::max<std::size_t>(1, taskSize / stride);
+					for(auto r = row; r < row + n; r += rows)
+						tasks.push_back({&e, r, std::min(r + rows, row + n), bytes + (r - row) * stride});
+				}
+				bytes += n * stride;
+				row += n;
+				if(row == e.size_)
+				{
+					first++;
+					row = 0;
+				}
+			}
+			auto src = buf.need(bytes);
+			if(!src)
+				throw std::runtime_error(std::format("unexpected end of file in element \"{}\"", tasks.back().e->name()));
+			internal::parallel(threads, tasks.size(), [&] (std::size_t t) {
+				auto & k = tasks[t];
+				k.e->readRows(src + k.offset, k.first, k.last, swapEndian);
+			});
+			buf.skip(bytes);
+		}
 	}
-	std::string_view prop::name() const
+
+	void root::readLines(internal::inbuf & buf, unsigned threads, std::size_t & first, std::size_t & row)
 	{
-		return parent_->names_.at(this);
+		struct task
+		{
+			elem*                 e;
+			std::size_t           line; // line of the first row
+			std::size_t           first;
+			std::size_t           last;
+			std::vector<std::any> locals; // flat lists of the rows
+		};
+		std::size_t const blockSize = std::size_t(threads) << 22;
+		std::vector<std::size_t> lines; // start of each line in the block
+		std::vector<task> tasks;
+		while(first < order_.size())
+		{
+			auto n = buf.lines(blockSize);
+			std::string_view body(buf.first(), n);
+			lines.clear();
+			for(std::size_t i = 0; i < n;)
+			{ // lines without values are part of the line before
+				auto j = i;
+				while(j < n && (body[j] == str::space || body[j] == '\t'))
+					j++;
+				if(j < n && body[j] != str::cr && body[j] != str::lf && std::string_view(str::ignoreLineSymbols).find(body[j]) == std::string_view::npos)
+					lines.push_back(i);
+				while(j < n && body[j] != str::cr && body[j] != str::lf)
+					j++;
+				while(j < n && (body[j] == str::cr || body[j] == str::lf))
+					j++;
+				i = j;
+			}
+			if(lines.empty())
+				return;
+			lines.push_back(n);
+
+			// the rows of the block
+			tasks.clear();
+			std::size_t line = 0;
+			auto ei = first;
+			auto r = row;
+			while(ei < order_.size() && line < lines.size() - 1)
+			{
+				auto & e = elements_[order_[ei]];
+				auto count = std::min(e.size_ - r, lines.size() - 1 - line);
+				auto chunk = std::max<std::size_t>(1024, count / (threads * 4));
+				for(auto a = r; a < r + count; a += chunk)
+				{
+					task t{&e, line + a - r, a, std::min(r + count, a + chunk), {}};
+					t.locals.resize(e.order_.size());
+					for(std::size_t pIdx = 0; pIdx < e.order_.size(); pIdx++)
+					{
+						auto & p = e.properties_[e.order_[pIdx]];
+						auto & info = *info_[p.tid_].get();
+						if(info.isList() && info.rows(p.data_))
+							t.locals[pIdx] = info.flat(t.last - t.first);
+					}
+					tasks.push_back(std::move(t));
+				}
+				line += count;
+				r += count;
+				if(r == e.size_)
+				{
+					ei++;
+					r = 0;
+				}
+			}
+
+			try
+			{
+				internal::parallel(threads, tasks.size(), [&] (std::size_t t) {
+					auto & k = tasks[t];
+					k.e->readLines(body, lines.data() + k.line - k.first, k.first, k.last, k.locals);
+				});
+			}
+			catch(internal::misaligned &)
+			{ // rows span lines, the serial parser continues
+				return;
+			}
+
+			// append the flat lists of all tasks
+			for(auto & t : tasks)
+			{
+				for(std::size_t pIdx = 0; pIdx < t.e->order_.size(); pIdx++)
+				{
+					auto & p = t.e->properties_[t.e->order_[pIdx]];
+					auto & info = *info_[p.tid_].get();
+					auto rows = info.isList() ? info.rows(p.data_) : nullptr;
+					if(!rows)
+						continue;
+					auto & local = *info.rows(t.locals[pIdx]);
+					auto base = rows->offsets[t.first];
+					for(std::size_t i = t.first; i < t.last; i++)
+						rows->offsets[i + 1] = base + local.offsets[i - t.first + 1];
+					info.resize(t.locals[pIdx], local.offsets[t.last - t.first]); // drop unused capacity
+					info.resize(p.data_, rows->offsets[t.last]);
+					info.splice(p.data_, base, t.locals[pIdx]);
+				}
+			}
+			for(; first < ei; first++)
+			{
+				auto & e = elements_[order_[first]];
+				for(auto & pn : e.order_)
+				{
+					auto & p = e.properties_[pn];
+					auto & info = *info_[p.tid_].get();
+					if(auto rows = info.isList() ? info.rows(p.data_) : nullptr)
+					{
+						internal::flatfill f{&info, &p.data_, rows};
+						f.finish(e.size_);
+					}
+				}
+			}
+			row = r;
+			buf.skip(lines[line]);
+		}
 	}
-	template<typename T> std::span<T> prop::get()
+
+	void root::readBody(std::istream & in, format fmt, std::endian endian)
 	{
-		if(tid_ != typeid(T))
-		{ // late initialization
-			if(tid_ == typeid(void))
+		using clock = std::chrono::steady_clock;
+		auto run = [this] (std::size_t first, std::size_t row, std::size_t last, std::size_t lastRow, clock::time_point start, std::size_t bytes) {
+			// the rows from (first, row) up to (last, lastRow) as one event
+			std::string names;
+			std::size_t rows = 0;
+			for(auto k = first; k <= last && k < order_.size(); k++)
 			{
-				tid_ = typeid(T);
-				auto & f = parent_->parent_->anyvec_[tid_];
-				if(!f) throw std::runtime_error(std::format("Unknown type: \"{}\" (size = {})", typeid(T).name(), sizeof(T)));
-				data_ = f(parent_->size_);
+				auto from = k == first ? row : 0;
+				auto to = k == last ? lastRow : elements_[order_[k]].size_;
+				if(to <= from)
+					continue;
+				names += names.empty() ? order_[k] : "," + order_[k];
+				rows += to - from;
 			}
-			else
-				throw std::runtime_error(std::format("Property::get<{}> is incompatible to the stored type \"{}\"", typeid(T).name(), tid_.name()));
+			report(event::phase::decode, names, start, bytes, rows);
+		};
+		auto decode = [this, fmt, endian, &run] (std::istream & src) {
+			auto & buf = dynamic_cast<internal::inbuf&>(*src.rdbuf());
+			auto threads = threads_ ? threads_ : std::max(1u, std::thread::hardware_concurrency());
+			if(fmt == format::ascii)
+			{ // ascii can hold a lot of garbage, it is sanitized while parsing
+				index_ = {};
+				std::size_t first = 0; // first element & row that are not decoded yet
+				std::size_t row = 0;
+				if(threads > 1)
+				{
+					auto start = sink_ ? clock::now() : clock::time_point();
+					auto at = buf.pos();
+					readLines(buf, threads, first, row);
+					if(sink_ && (first || row))
+						run(0, 0, first, row, start, buf.pos() - at);
+				}
+				for(; first < order_.size(); first++, row = 0)
+				{
+					auto start = sink_ ? clock::now() : clock::time_point();
+					auto at = buf.pos();
+					elements_[order_[first]].parseRows(buf, row);
+					if(sink_)
+						run(first, row, first + 1, 0, start, buf.pos() - at);
+				}
+				return;
+			}
+			index_ = {indexStep_, {}};
+			std::size_t base = 0; // of the current element
+			for(std::size_t i = 0; i < order_.size(); i++)
+			{
+				auto & e = elements_[order_[i]];
+				if(threads > 1 && stride(e))
+				{ // the offsets of the rows are known up to the next element with lists
+					auto last = i + 1;
+					while(last < order_.size() && (stride(elements_[order_[last]]) || elements_[order_[last]].order_.empty()))
+						last++;
+					auto start = sink_ ? clock::now() : clock::time_point();
+					auto at = buf.pos();
+					readRows(buf, threads, i, last, endian != std::endian::native);
+					if(sink_)
+						run(i, 0, last, 0, start, buf.pos() - at);
+					for(auto k = i; indexStep_ && k < last; k++)
+					{
+						auto & o = index_.offsets[order_[k]];
+						internal::strideOffsets(o, indexStep_, elements_[order_[k]].size_, stride(elements_[order_[k]]));
+						internal::rebase(o, base);
+					}
+					i = last - 1;
+					continue;
+				}
+				auto offsets = indexStep_ ? &index_.offsets[order_[i]] : nullptr;
+				auto start = sink_ ? clock::now() : clock::time_point();
+				auto at = buf.pos();
+				if(endian == std::endian::little)
+					e.read<format::binary, std::endian::little>(src, indexStep_, offsets);
+				else
+					e.read<format::binary, std::endian::big>(src, indexStep_, offsets);
+				if(sink_)
+					run(i, 0, i + 1, 0, start, buf.pos() - at);
+				if(offsets)
+					internal::rebase(*offsets, base);
+			}
+		};
+		if(dynamic_cast<internal::inbuf*>(in.rdbuf()))
+			decode(in);
+		else if(prefetch_)
+		{ // read the next blocks while decoding
+			internal::prefetchbuf pre(in.rdbuf());
+			internal::inbuf buf(&pre);
+			std::istream body(&buf);
+			decode(body);
+		}
+		else
+		{ // read large blocks instead of single values
+			internal::inbuf buf(in.rdbuf());
+			std::istream body(&buf);
+			decode(body);
+			buf.unread();
 		}
-		return std::any_cast<std::vector<T> &>(data_);
 	}
-	template<typename T> void prop::set(std::span<T const> src)
+
+	template<format ff, std::endian ee>
+	void root::write(std::string const & path, rowindex* index) const
 	{
-		auto dst = get<T>();
-		std::copy_n(src.begin(), src.size(), dst.begin());
+		std::ofstream out(path, std::ios::binary | std::ios::trunc | std::ios::out);
+		if(!out.good())
+			throw std::runtime_error(std::format("Cannot open file in write mode \"{}\"", path));
+		write<ff, ee>(out, index);
 	}
-	template<typename T> void prop::set(std::vector<T> const & src)
+
+	std::string root::str() const
 	{
-		auto dst = get<T>();
-		std::copy_n(src.begin(), src.size(), dst.begin());
+		std::ostringstream out;
+		write<format::ascii>(out);
+		return out.str();
+	}
+
+	template<format ff, std::endian ee>
+	void root::write(std::ostream & out, rowindex* index) const
+	{
+		using clock = std::chrono::steady_clock;
+		auto start = sink_ ? clock::now() : clock::time_point();
+		auto at = sink_ ? internal::position(out) : 0;
+		writeHeader<ff, ee>(out);
+		if(sink_)
+			report(event::phase::header, {}, start, internal::position(out) - at, 0);
+		if(ff == format::ascii || !indexStep_)
+			index = nullptr;
+		if(index)
+			*index = {indexStep_, {}};
+		std::size_t base = 0; // of the current element
+		for(std::size_t i = 0; i < order_.size(); i++)
+		{
+			if(sink_)
+			{
+				start = clock::now();
+				at = internal::position(out);
+			}
+			if constexpr(ff == format::ascii)
+			{
+				elements_.at(order_[i]).write<ff, ee>(out);
+				if(i < order_.size() - 1) out << linesep_;
+			}
+			else
+			{
+				auto offsets = index ? &index->offsets[order_[i]] : nullptr;
+				elements_.at(order_[i]).write<ff, ee>(out, {}, indexStep_, offsets);
+				if(offsets)
+					internal::rebase(*offsets, base);
+			}
+			if(sink_)
+				report(event::phase::encode, order_[i], start, internal::position(out) - at, elements_.at(order_[i]).size_);
+		}
+	}
+
+	template<format ff, std::endian ee>
+	void root::writeHeader(std::ostream & out) const
+	{
+		out << str::ply << linesep_;
+		out << str::format << " " << internal::formatName<ff, ee>() << " " << str::version << linesep_;
+		for(auto const & c : comments_)
+			if(c.find_first_of(str::invalidSymbols) == std::string::npos) // filter all the illegal stuff
+				out << str::comment << " " << c << linesep_;
+		auto ne = order_.size();
+		for(std::size_t i = 0; i < ne; i++)
+		{
+			auto const & e = elements_.at(order_[i]);
+			out << str::elem << " " << e.name() << " " << e.size() << linesep_;
+			for(auto const & pname : e.order_)
+			{
+				auto const & p = e.properties_.at(pname);
+				auto const & type = *ios_.at(p.tid_).get();
+				auto const & info = *info_.at(p.tid_).get();
+				out << str::prop << " ";
+				if(info.isList()) out << str::list << " " << internal::listIndexTypeName(p.data_.has_value() ? info.listIndexTypeSize(p.data_) : p.listIndexSize_) << " ";
+				out << type.names()[0] << " " << p.name() << linesep_;
+			}
+		}
+		out << str::end_header << linesep_;
 	}
-	std::type_index prop::listType() const
+
+	// ---------------------------------------------------------------
+	// Row index
+	// ---------------------------------------------------------------
+
+	void rowindex::save(std::string const & path) const
 	{
-		return tid_;
+		std::ofstream out(path, std::ios::trunc | std::ios::out);
+		if(!out.good())
+			throw std::runtime_error(std::format("Cannot open file in write mode \"{}\"", path));
+		out << str::step << str::space << step << str::lf;
+		for(auto const & [name, o] : offsets)
+		{
+			out << name << str::space << o.size();
+			for(auto x : o)
+				out << str::space << x;
+			out << str::lf;
+		}
 	}
-	std::type_index prop::type() const
+
+	void rowindex::load(std::string const & path)
 	{
-		return parent_->parent_->info_[tid_]->tid();
+		std::ifstream in(path, std::ios::in);
+		if(!in.good())
+			throw std::runtime_error(std::format("cannot open file in read mode: \"{}\"", path));
+		rowindex loaded;
+		std::string word;
+		if(!(in >> word >> loaded.step) || word != str::step)
+			throw std::runtime_error(std::format("invalid index file: \"{}\"", path));
+		std::size_t n = 0;
+		while(in >> word >> n)
+		{
+			auto & o = loaded.offsets[word];
+			o.resize(n);
+			for(auto & x : o)
+				if(!(in >> x))
+					throw std::runtime_error(std::format("invalid index file: \"{}\"", path));
+		}
+		if(!in.eof())
+			throw std::runtime_error(std::format("invalid index file: \"{}\"", path));
+		*this = std::move(loaded);
 	}
-	bool prop::isList() const
-	{
-		if(tid_ == typeid(void))
-			throw std::runtime_error("Property::isList cannot be used before type initialization");
-		return parent_->parent_->info_[tid_]->isList();
-	};
 
 	// ---------------------------------------------------------------
-	// Element
+	// Reader
 	// ---------------------------------------------------------------
 
-	bool elem::has(std::string_view sv) const
+	reader::reader(std::istream & in) : in_(&in)
 	{
-		return properties_.contains(std::string(sv));
+		open();
 	}
 
-	prop & elem::operator()(std::string_view name)
+	reader::reader(std::string const & path)
 	{
-		auto [it, inserted] = properties_.try_emplace(std::string(name));
-		if(inserted)
-		{
-			order_.push_back(std::string(name));
-			names_[&it->second] = std::string(name);
-			it->second.parent_ = this;
-		}
-		return it->second;
+		file_ = std::make_unique<std::ifstream>(path, std::ios::binary | std::ios::in);
+		if(!file_->good())
+			throw std::runtime_error(std::format("cannot open file in read mode: \"{}\"", path));
+		in_ = file_.get();
+		open();
 	}
 
-	prop & elem::operator()(std::string_view name, std::type_index const & tid)
+	void reader::open()
 	{
-		if(!parent_->ios_.contains(tid))
-			throw std::runtime_error(std::format("No IO defined for type \"{}\"", tid.name()));
-		auto [it, inserted] = properties_.try_emplace(std::string(name));
-		if(inserted)
-		{
-			order_.push_back(std::string(name));
-			names_[&it->second] = std::string(name);
-			it->second.parent_ = this;
-			it->second.data_ = parent_->anyvec_[tid](size_);
-			it->second.tid_ = tid;
+		std::tie(fmt_, endian_) = header_.readHeader(*in_);
+		for(auto & en : header_.order_)
+		{ // same elements & properties for the chunks
+			auto & e = header_.elements_[en];
+			auto & c = chunks_(en, 0);
+			for(auto & pn : e.order_)
+			{
+				auto & p = e.properties_[pn];
+				c.declare(pn, p.tid_).listIndexSize_ = p.listIndexSize_;
+			}
 		}
-		return it->second;
+		start_ = in_->tellg();
+		rewire();
 	}
 
-	prop & elem::operator()(std::span<std::string_view const> names)
+	void reader::rewire(std::streampos at)
 	{
-		for(auto const & n : names)
-			if(has(n))
-				return operator()(n);
-		std::string s;
-		for(int i = 0; i < static_cast<int>(names.size()); ++i)
-			s += std::string(names[i]) + (i < static_cast<int>(names.size()) - 1 ? " || " : "");
-		throw std::runtime_error(std::format("Element does not contain property \"{}\"", s));
+		body_.reset();
+		buf_.reset();
+		pre_.reset();
+		if(at != std::streampos(-1))
+		{
+			in_->clear();
+			in_->seekg(at);
+			if(!in_->good())
+				throw std::runtime_error("cannot seek in the stream");
+		}
+		if(chunks_.prefetch_)
+			pre_ = std::make_unique<internal::prefetchbuf>(in_->rdbuf());
+		buf_ = std::make_unique<internal::inbuf>(pre_ ? static_cast<std::streambuf*>(pre_.get()) : in_->rdbuf());
+		body_ = std::make_unique<std::istream>(buf_.get());
 	}
 
-	std::size_t elem::size() const
+	const root & reader::header() const
 	{
-		return size_;
+		return header_;
 	}
-	std::string_view elem::name() const
+
+	bool reader::flatLists(bool newFlat)
 	{
-		return parent_->names_.at(this);
+		return chunks_.flatLists(newFlat);
 	}
 
-	void elem::del(std::string_view n)
+	bool reader::prefetch(bool newPrefetch)
 	{
-		auto it = properties_.find(std::string(n));
-		if(it == properties_.end())
-			throw std::runtime_error(std::format("cannot delete something that does not exist element.{}", n));
-		names_.erase(&it->second);
-		properties_.erase(std::string(n));
-		for(std::size_t i = 0; i < order_.size(); i++)
-		{
-			if(order_[i] == n)
-			{
-				order_.erase(order_.begin() + i);
-				break;
-			}
-		}
+		if(buf_->pos() || buf_->available())
+			throw std::runtime_error("prefetch has to be set before reading rows");
+		auto old = chunks_.prefetch(newPrefetch);
+		rewire();
+		return old;
 	}
 
-	template<format ff, std::endian ee>
-	void elem::write(std::ostream & out) const
+	bool reader::next(std::size_t n)
 	{
-		std::size_t np = order_.size();
-		std::vector<const type *> ios(np); // serializer & deserializer for each property
-		std::vector<const void*> ptrs(np); // ptr on the vectors (NOT the data)
-		std::vector<std::uint8_t> lsiz(np); // list index type sizes
-		for(std::size_t pIdx = 0; pIdx < np; pIdx++)
+		if(!n)
+			throw std::runtime_error("chunks need at least one row");
+		auto & order = header_.order_;
+		if(chunk_)
+			first_ += chunk_->size_;
+		while(element_ < order.size() && first_ >= header_.elements_[order[element_]].size_)
 		{
-			auto const & p = properties_.at(order_[pIdx]);
-			ios[pIdx] = parent_->ios_[p.tid_].get();
-			auto & info = *parent_->info_[p.tid_].get();
-			ptrs[pIdx] = info.vecPtr(p.data_);
-			lsiz[pIdx] = info.listIndexTypeSize(p.data_);
+			element_++;
+			first_ = 0;
 		}
-		if constexpr(ff == format::ascii)
+		if(element_ == order.size())
 		{
-			for(std::size_t i = 0; i < size_; i++)
-			{
-				for(std::size_t pIdx = 0; pIdx < np; pIdx++)
-				{
-					ios[pIdx]->ascO(out, ptrs[pIdx], i);
-					if(pIdx < np - 1) out << " ";
-				}
-				if(i < size_ - 1) out << parent_->linesep_;
-			}
+			chunk_ = nullptr;
+			return false;
 		}
-		else if constexpr(ff == format::binary)
-		{
-			for(std::size_t i = 0; i < size_; i++)
-				for(std::size_t pIdx = 0; pIdx < np; pIdx++)
-					ios[pIdx]->binO(out, ptrs[pIdx], i, lsiz[pIdx], ee != std::endian::native);
+		auto & e = chunks_.elements_[order[element_]];
+		e.size_ = std::min(n, header_.elements_[order[element_]].size_ - first_);
+		for(auto & pn : e.order_)
+		{ // the buffers of the last chunk are reused
+			auto & p = e.properties_[pn];
+			auto & info = *chunks_.info_[p.tid_].get();
+			if(p.data_.has_value())
+				info.reshape(p.data_, e.size_);
+			else
+				p.data_ = chunks_.flat_ && info.isList() ? info.flat(e.size_) : chunks_.anyvec_[p.tid_](e.size_);
 		}
+		if(fmt_ == format::ascii)
+			e.parseRows(*buf_, 0);
+		else if(endian_ == std::endian::little)
+			e.read<format::binary, std::endian::little>(*body_);
 		else
-			throw std::runtime_error("Unknown output format");
+			e.read<format::binary, std::endian::big>(*body_);
+		chunk_ = &e;
+		return true;
 	}
 
-	template<format ff, std::endian ee>
-	void elem::read(std::istream & in)
+	elem & reader::chunk()
 	{
-		std::size_t np = order_.size();
-		std::vector<const type *> ios(np); // serializer & deserializer for each property
-		std::vector<void*> ptrs(np); // ptr on the vectors (NOT the data)
-		std::vector<std::uint8_t> lsiz(np); // list index type sizes
-		for(std::size_t pIdx = 0; pIdx < np; pIdx++)
-		{
-			auto & p = properties_[order_[pIdx]];
-			ios[pIdx] = parent_->ios_[p.tid_].get();
-			auto & info = *parent_->info_[p.tid_].get();
-			ptrs[pIdx] = info.vecPtr(p.data_);
-			lsiz[pIdx] = p.listIndexSize_;
+		if(!chunk_)
+			throw std::runtime_error("no chunk, call next() first");
+		return *chunk_;
+	}
+
+	std::size_t reader::first() const
+	{
+		return first_;
+	}
+
+	void reader::seek(std::string_view name, std::size_t row, rowindex const * index)
+	{
+		if(fmt_ != format::binary)
+			throw std::runtime_error("rows can only be found in binary files");
+		if(start_ == std::streampos(-1))
+			throw std::runtime_error("cannot seek in a stream without position");
+		if(!header_.has(name))
+			throw std::runtime_error(std::format("element \"{}\" does not exist", name));
+		auto & order = header_.order_;
+		auto & e = header_.elements_[std::string(name)];
+		if(row > e.size_)
+			throw std::runtime_error(std::format("element \"{}\" has only {} rows", name, e.size_));
+		auto indexed = [this, index] (std::string const & en) -> const std::vector<std::size_t>* {
+			if(!index || !index->step || !index->offsets.contains(en))
+				return nullptr;
+			auto & o = index->offsets.at(en);
+			if(o.size() != (header_.elements_[en].size_ + index->step - 1) / index->step + 1)
+				throw std::runtime_error(std::format("index does not match element \"{}\"", en));
+			return &o;
+		};
+		std::size_t element = 0;
+		std::size_t offset = 0; // from the first byte after the header
+		std::size_t first = row; // row at offset
+		for(; order[element] != name; element++)
+		{ // skip the elements before
+			auto & b = header_.elements_[order[element]];
+			if(auto stride = header_.stride(b); stride || b.order_.empty())
+				offset += stride * b.size_;
+			else if(auto o = indexed(order[element]))
+				offset = o->back();
+			else
+				throw std::runtime_error(std::format("element \"{}\" has rows of a variable size, seeking behind it needs an index", order[element]));
 		}
-		if constexpr(ff == format::ascii)
+		if(auto o = indexed(order[element]))
 		{
-			for(std::size_t i = 0; i < size_; i++)
-				for(std::size_t pIdx = 0; pIdx < np; pIdx++)
-					ios[pIdx]->ascI(in, ptrs[pIdx], i);
+			offset = (*o)[row / index->step];
+			first = row / index->step * index->step;
 		}
-		else if constexpr(ff == format::binary)
-		{
-			for(std::size_t i = 0; i < size_; i++)
-				for(std::size_t pIdx = 0; pIdx < np; pIdx++)
-					ios[pIdx]->binI(in, ptrs[pIdx], i, lsiz[pIdx], ee != std::endian::native);
+		else if(auto stride = header_.stride(e); stride || e.order_.empty())
+			offset += stride * row;
+		else if(row)
+			throw std::runtime_error(std::format("element \"{}\" has rows of a variable size, seeking inside it needs an index", name));
+		rewire(start_ + static_cast<std::streamoff>(offset));
+		element_ = element;
+		first_ = first;
+		chunk_ = nullptr;
+		if(row > first)
+		{ // decode the rows between the indexed one and row
+			next(row - first);
+			first_ += chunk_->size_;
+			chunk_ = nullptr;
 		}
 	}
 
 	// ---------------------------------------------------------------
-	// Root
+	// Typed
 	// ---------------------------------------------------------------
 
-	bool root::has(std::string_view en) const
+	template<typename... E>
+	void typed::read(std::string const & path, E &... tables)
 	{
-		return elements_.contains(std::string(en));
+		std::ifstream in(path, std::ios::binary | std::ios::in);
+		if(!in.good())
+			throw std::runtime_error(std::format("cannot open file in read mode: \"{}\"", path));
+		read(in, tables...);
 	}
 
-	bool root::has(std::string_view en, std::string_view pn) const
+	template<typename... E>
+	void typed::read(std::istream & in, E &... tables)
 	{
-		if(!elements_.contains(std::string(en)))
-			return false;
-		return elements_.at(std::string(en)).has(pn);
+		root header;
+		auto [fmt, endian] = header.readHeader(in);
+		if(header.order_.size() != sizeof...(E))
+			throw std::runtime_error(std::format("file has {} elements instead of {}", header.order_.size(), sizeof...(E)));
+		std::size_t i = 0;
+		(check(header, i++, tables), ...);
+		internal::inbuf buf(in.rdbuf());
+		if(fmt == format::ascii)
+		{ // values are parsed in place
+			i = 0;
+			(parseRows(buf, header.elements_[header.order_[i++]].size_, tables), ...);
+			buf.unread();
+			return;
+		}
+		if(endian == std::endian::little)
+			(decode<std::endian::little>(buf, tables), ...);
+		else
+			(decode<std::endian::big>(buf, tables), ...);
+		buf.unread();
 	}
 
-	void root::del(std::string_view n)
+	template<typename... T>
+	void typed::check(root & header, std::size_t i, table<T...> & t)
 	{
-		auto it = elements_.find(std::string(n));
-		if(it == elements_.end())
-			throw std::runtime_error(std::format("cannot delete something that does not exist root.{}", n));
-		names_.erase(&it->second);
-		elements_.erase(std::string(n));
-		for(std::size_t i = 0; i < order_.size(); i++)
+		auto & e = header.elements_[header.order_[i]];
+		if(header.order_[i] != t.name || e.order_.size() != sizeof...(T))
+			throw std::runtime_error(std::format("element \"{}\" does not match \"{}\"", header.order_[i], t.name));
+		std::array<std::type_index, sizeof...(T)> tids{typeid(T)...};
+		for(std::size_t j = 0; j < sizeof...(T); j++)
 		{
-			if(order_[i] == n)
+			auto & p = e.properties_[e.order_[j]];
+			if(e.order_[j] != t.properties[j] || p.tid_ != tids[j])
+				throw std::runtime_error(std::format("property \"{}\" of element \"{}\" does not match the name or type of \"{}\"", e.order_[j], t.name, t.properties[j]));
+			t.listIndexSizes[j] = p.listIndexSize_;
+		}
+		t.resize(e.size_);
+	}
+
+	template<std::endian ee, typename... T>
+	void typed::decode(internal::inbuf & buf, table<T...> & t)
+	{
+		constexpr bool swapEndian = ee != std::endian::native;
+		auto bytes = [&buf, &t] (std::size_t n) {
+			auto src = buf.need(n);
+			if(!src)
+				throw std::runtime_error(std::format("unexpected end of file in element \"{}\"", t.name));
+			return src;
+		};
+		auto const size = t.size();
+		if constexpr(!(internal::isVector<T>::value || ...))
+		{ // rows of a fixed size are decoded block by block, column by column
+			constexpr std::size_t stride = (sizeof(T) + ...);
+			std::size_t const rowsPerBlock = std::max<std::size_t>(1, (std::size_t(1) << 18) / stride);
+			for(std::size_t i = 0; i < size; i += rowsPerBlock)
 			{
-				order_.erase(order_.begin() + i);
-				break;
+				auto n = std::min(rowsPerBlock, size - i);
+				auto src = bytes(n * stride);
+				[&]<std::size_t... I> (std::index_sequence<I...>) {
+					std::size_t offset = 0;
+					((internal::copy<sizeof(T), (swapEndian && sizeof(T) > 1)>(src + offset, stride, reinterpret_cast<char*>(std::get<I>(t.columns).data() + i), sizeof(T), n), offset += sizeof(T)), ...);
+				}(std::index_sequence_for<T...>{});
+				buf.skip(n * stride);
 			}
+			return;
 		}
+		auto value = [&] <typename V> (V & x, std::uint8_t lsiz) {
+			if constexpr(internal::isVector<V>::value)
+			{
+				using W = typename V::value_type;
+				auto n = internal::listIndex(bytes(lsiz), lsiz, swapEndian);
+				buf.skip(lsiz);
+				x.resize(n);
+				internal::copy<sizeof(W), (swapEndian && sizeof(W) > 1)>(bytes(n * sizeof(W)), sizeof(W), reinterpret_cast<char*>(x.data()), sizeof(W), n);
+				buf.skip(n * sizeof(W));
+			}
+			else
+			{
+				internal::copy<sizeof(V), (swapEndian && sizeof(V) > 1)>(bytes(sizeof(V)), 0, reinterpret_cast<char*>(&x), 0, 1);
+				buf.skip(sizeof(V));
+			}
+		};
+		for(std::size_t i = 0; i < size; i++)
+			[&]<std::size_t... I> (std::index_sequence<I...>) {
+				(value(std::get<I>(t.columns)[i], t.listIndexSizes[I]), ...);
+			}(std::index_sequence_for<T...>{});
 	}
 
-	std::vector<std::reference_wrapper<elem>> root::elements()
+	template<typename E>
+	void typed::parseRows(internal::inbuf & buf, std::size_t rows, E & e)
 	{
-		std::vector<std::reference_wrapper<elem>> info;
-		for(auto & [n, e] : elements_)
-			info.emplace_back(e);
-		return info;
+		// rows are parsed from a window of complete lines that is refilled when it runs low
+		std::size_t window = std::size_t(1) << 20;
+		const char* cur = buf.first();
+		const char* end = cur;
+		bool eof = false;
+		auto refill = [&] () {
+			buf.skip(static_cast<std::size_t>(cur - buf.first()));
+			auto n = buf.lines(window);
+			eof = buf.available() < window;
+			cur = buf.first();
+			end = cur + n;
+		};
+		if(rows)
+			refill();
+		for(std::size_t i = 0; i < rows;)
+		{
+			try
+			{
+				cur = parse(cur, end, i, e);
+				i++;
+				if(!eof && static_cast<std::size_t>(end - cur) < window / 16)
+					refill();
+			}
+			catch(internal::truncated &)
+			{ // the row continues after the complete lines
+				if(eof)
+					throw;
+				if(static_cast<std::size_t>(buf.last() - cur) >= window)
+					window *= 2;
+				refill();
+			}
+		}
+		buf.skip(static_cast<std::size_t>(cur - buf.first()));
 	}
 
-	std::vector<std::string> root::names() const
+	template<typename... T>
+	const char* typed::parse(const char* cur, const char* last, std::size_t i, table<T...> & t)
 	{
-		std::vector<std::string> info;
-		for(auto & [n, e] : elements_)
-			info.emplace_back(e.name());
-		return info;
+		auto value = [&cur, last] <typename V> (V & x) {
+			if constexpr(internal::isVector<V>::value)
+			{
+				std::int64_t n = 0;
+				cur = internal::fromChars(cur, last, n);
+				if(n < 0)
+					throw std::runtime_error("Negative size for property list");
+				x.resize(static_cast<std::size_t>(n));
+				for(auto & y : x)
+					cur = internal::fromChars(cur, last, y);
+			}
+			else
+				cur = internal::fromChars(cur, last, x);
+		};
+		std::apply([&value, i] (auto &... c) { (value(c[i]), ...); }, t.columns);
+		return cur;
 	}
 
-	char root::lineSeperator(char newLinesep)
+	template<format ff, std::endian ee, typename... E>
+	void typed::write(std::string const & path, E const &... tables)
 	{
-		std::swap(linesep_, newLinesep);
-		return newLinesep;
+		std::ofstream out(path, std::ios::binary | std::ios::trunc | std::ios::out);
+		if(!out.good())
+			throw std::runtime_error(std::format("Cannot open file in write mode \"{}\"", path));
+		write<ff, ee>(out, tables...);
 	}
 
-	std::vector<std::string> & root::comments()
+	template<format ff, std::endian ee, typename... E>
+	void typed::write(std::ostream & out, E const &... tables)
 	{
-		return comments_;
+		root header;
+		(declare(header, tables), ...);
+		header.writeHeader<ff, ee>(out);
+		if constexpr(ff == format::ascii)
+		{ // elements are separated by a line break
+			std::size_t i = 0;
+			(print(out, tables, ++i < sizeof...(E)), ...);
+		}
+		else
+			(encode<ee>(out, tables), ...);
 	}
-	elem & root::operator()(std::string_view name, std::size_t size)
+
+	template<typename... T>
+	void typed::declare(root & header, table<T...> const & t)
 	{
-		auto [it, inserted] = elements_.try_emplace(std::string(name));
-		if(inserted)
-		{
-			order_.push_back(std::string(name));
-			names_[&it->second] = std::string(name);
-			it->second.size_ = size;
-			it->second.parent_ = this;
-		}
-		return it->second;
+		auto & e = header(t.name, t.size());
+		std::array<std::type_index, sizeof...(T)> tids{typeid(T)...};
+		auto lsiz = indexSizes(t);
+		for(std::size_t j = 0; j < sizeof...(T); j++)
+			e.declare(t.properties[j], tids[j]).listIndexSize_ = lsiz[j];
 	}
-	elem & root::operator()(std::string_view name)
+
+	template<typename... T>
+	std::array<std::uint8_t, sizeof...(T)> typed::indexSizes(table<T...> const & t)
 	{
-		if(!elements_.contains(std::string(name)))
-			throw std::runtime_error("cannot access non initialized element");
-		// this could be partial initialization without size, but then the size needs to come from "somewhere"...
-		return elements_[std::string(name)];
+		std::array<std::uint8_t, sizeof...(T)> lsiz{};
+		[&]<std::size_t... I> (std::index_sequence<I...>) {
+			((lsiz[I] = [&t] () -> std::uint8_t {
+				if constexpr(internal::isVector<T>::value)
+				{
+					std::size_t n = 0;
+					for(auto & x : std::get<I>(t.columns))
+						n = std::max(n, x.size());
+					std::uint8_t fits = n <= 0xFF ? 1 : n <= 0xFFFF ? 2 : 4;
+					if(t.listIndexSizes[I] && t.listIndexSizes[I] < fits)
+						throw std::runtime_error(std::format("property list \"{}\" of element \"{}\" does not fit its list index", t.properties[I], t.name));
+					return t.listIndexSizes[I] ? t.listIndexSizes[I] : fits;
+				}
+				else
+					return 0;
+			}()), ...);
+		}(std::index_sequence_for<T...>{});
+		return lsiz;
 	}
-	elem const & root::operator()(std::string_view name) const
+
+	template<std::endian ee, typename... T>
+	void typed::encode(std::ostream & out, table<T...> const & t)
 	{
-		if(!elements_.contains(std::string(name)))
-			throw std::runtime_error("cannot access non initialized element");
-		// this could be partial initialization without size, but then the size needs to come from "somewhere"...
-		return elements_.at(std::string(name));
+		constexpr bool swapEndian = ee != std::endian::native;
+		auto const size = t.size();
+		if constexpr(!(internal::isVector<T>::value || ...))
+		{ // rows of a fixed size are encoded block by block, column by column
+			constexpr std::size_t stride = (sizeof(T) + ...);
+			std::size_t const rowsPerBlock = std::max<std::size_t>(1, (std::size_t(1) << 18) / stride);
+			std::vector<char> block(std::min(rowsPerBlock, size) * stride);
+			for(std::size_t i = 0; i < size; i += rowsPerBlock)
+			{
+				auto n = std::min(rowsPerBlock, size - i);
+				[&]<std::size_t... I> (std::index_sequence<I...>) {
+					std::size_t offset = 0;
+					((internal::copy<sizeof(T), (swapEndian && sizeof(T) > 1)>(reinterpret_cast<const char*>(std::get<I>(t.columns).data() + i), sizeof(T), block.data() + offset, stride, n), offset += sizeof(T)), ...);
+				}(std::index_sequence_for<T...>{});
+				out.write(block.data(), static_cast<std::streamsize>(n * stride));
+			}
+			return;
+		}
+		// rows of a variable size are packed into a reusable buffer that is written in large blocks
+		std::size_t const blockSize = std::size_t(1) << 20;
+		std::string block;
+		block.reserve(blockSize + 256);
+		auto value = [&block] <typename V> (V const & x, std::uint8_t lsiz) {
+			auto at = block.size();
+			if constexpr(internal::isVector<V>::value)
+			{
+				using W = typename V::value_type;
+				block.resize(at + lsiz + x.size() * sizeof(W));
+				internal::listIndex(block.data() + at, x.size(), lsiz, swapEndian);
+				internal::copy<sizeof(W), (swapEndian && sizeof(W) > 1)>(reinterpret_cast<const char*>(x.data()), sizeof(W), block.data() + at + lsiz, sizeof(W), x.size());
+			}
+			else
+			{
+				block.resize(at + sizeof(V));
+				internal::copy<sizeof(V), (swapEndian && sizeof(V) > 1)>(reinterpret_cast<const char*>(&x), 0, block.data() + at, 0, 1);
+			}
+		};
+		auto lsiz = indexSizes(t); // as declared in the header
+		for(std::size_t i = 0; i < size; i++)
+		{
+			[&]<std::size_t... I> (std::index_sequence<I...>) {
+				(value(std::get<I>(t.columns)[i], lsiz[I]), ...);
+			}(std::index_sequence_for<T...>{});
+			if(block.size() >= blockSize)
+			{
+				out.write(block.data(), static_cast<std::streamsize>(block.size()));
+				block.clear();
+			}
+		}
+		out.write(block.data(), static_cast<std::streamsize>(block.size()));
 	}
 
-	template<typename T, template<typename, bool> typename CustomIO> void root::registerType()
+	template<typename... T>
+	void typed::print(std::ostream & out, table<T...> const & t, bool more)
 	{
-		ios_.insert({typeid(T),std::make_unique<CustomIO<T, false>>()});
-		info_.insert({typeid(T),std::make_unique<internal::ErasedInfo<T, false>>()});
-		anyvec_.insert({typeid(T), [] (std::size_t s) { return std::vector<T>(s); }});
-		ios_.insert({typeid(std::vector<T>),std::make_unique<CustomIO<T, true>>()});
-		info_.insert({typeid(std::vector<T>),std::make_unique<internal::ErasedInfo<T, true>>()});
-		anyvec_.insert({typeid(std::vector<T>), [] (std::size_t s) { return std::vector<std::vector<T>>(s); }});
+		std::size_t const blockSize = std::size_t(1) << 20;
+		std::string block;
+		block.reserve(blockSize + 256);
+		auto value = [&block] <typename V> (V const & x) {
+			char b[32];
+			if constexpr(internal::isVector<V>::value)
+			{
+				block.append(b, internal::toChars(b, x.size(), false));
+				for(auto & y : x)
+				{
+					block += str::space;
+					block.append(b, internal::toChars(b, y, false));
+				}
+			}
+			else
+				block.append(b, internal::toChars(b, x, false));
+		};
+		auto const size = t.size();
+		for(std::size_t i = 0; i < size; i++)
+		{
+			std::apply([&value, &block, i] (auto const &... c) {
+				std::size_t j = 0;
+				((j++ ? void(block += str::space) : void(), value(c[i])), ...);
+			}, t.columns);
+			if(i < size - 1)
+				block += str::lf;
+			if(block.size() >= blockSize)
+			{
+				out.write(block.data(), static_cast<std::streamsize>(block.size()));
+				block.clear();
+			}
+		}
+		if(more)
+			block += str::lf;
+		out.write(block.data(), static_cast<std::streamsize>(block.size()));
 	}
 
-	std::type_index root::typeidFromStr(std::string_view s, bool isList)
+	template<typename S>
+	template<typename T>
+	binding<S>& binding<S>::bind(std::string_view property, T S::* member)
 	{
-		for(auto const & [tid, ios] : ios_)
-			for(auto & sw : ios->names())
-				if(sw == s) return isList ? info_[tid]->vecTid() : tid;
-		return typeid(void);
+		alignas(S) std::byte probe[sizeof(S)]; // never constructed, only the address of the member is taken
+		auto s = reinterpret_cast<S*>(probe);
+		return bind<T>(property, static_cast<std::size_t>(reinterpret_cast<std::byte*>(&(s->*member)) - probe));
 	}
 
-	void root::read(std::string const & path)
+	template<typename S>
+	template<typename T>
+	binding<S>& binding<S>::bind(std::string_view property, std::size_t offset)
 	{
-		std::ifstream in(path, std::ios::binary | std::ios::in);
-		if(!in.good())
-			throw std::runtime_error(std::format("cannot open file in read mode: \"{}\"", path));
-		read(in);
+		static_assert(std::is_arithmetic_v<T>, "only plain values can be bound, use a table for lists");
+		if(offset + sizeof(T) > sizeof(S))
+			throw std::runtime_error(std::format("property \"{}\" of element \"{}\" is bound outside of the struct", property, name));
+		fields.push_back({
+			std::string(property),
+			typeid(T),
+			offset,
+			sizeof(T),
+			[] (const char* first, const char* last, void* x) { return internal::fromChars(first, last, *static_cast<T*>(x)); },
+			[] (std::string & block, const void* x) {
+				char b[32];
+				T y;
+				std::memcpy(&y, x, sizeof(T));
+				block.append(b, internal::toChars(b, y, false));
+			}});
+		return *this;
 	}
 
-	void root::read(std::istream & in)
+	template<typename S>
+	void typed::check(root & header, std::size_t i, binding<S> & b)
 	{
-		comments_.clear();
-		elements_.clear();
-		names_.clear();
-		order_.clear();
-		std::string line;
-		std::size_t lIdx = 0;
-		std::uint32_t crlfCounter = 0;
-		char lastDecodedChar;
-		format fmt = format::ascii;
-		std::endian endian = std::endian::native;
-		elem * lastElement = nullptr;
-		while(true)
+		auto & e = header.elements_[header.order_[i]];
+		if(header.order_[i] != b.name)
+			throw std::runtime_error(std::format("element \"{}\" does not match \"{}\"", header.order_[i], b.name));
+		b.slots_.assign(e.order_.size(), {});
+		std::vector<bool> found(b.fields.size());
+		for(std::size_t j = 0; j < e.order_.size(); j++)
 		{
-			crlfCounter += internal::getline(in, line, lastDecodedChar);
-			if(!line.size() || line == str::end_header)
-				break;
-			if(lIdx == 0)
-			{
-				if(!line.starts_with(str::ply))
-					throw std::runtime_error(std::format("read line {}: wrong magic number in ply file", lIdx + 1));
-			}
-			else if(lIdx == 1)
-			{
-				auto a = internal::split(line, str::space);
-				if(a.size() < 3 || a[0] != str::format)
-					throw std::runtime_error(std::format("read line {}: invalid", lIdx));
-				if(a[1] == str::ascii)
-					fmt = format::ascii;
-				else if(a[1] == str::binary_big_endian)
-				{
-					fmt = format::binary;
-					endian = std::endian::big;
-				}
-				else if(a[1] == str::binary_little_endian)
+			auto & p = e.properties_[e.order_[j]];
+			auto & slot = b.slots_[j];
+			auto & info = *header.info_.at(p.tid_);
+			slot.size = info.typeSize();
+			slot.listIndexSize = info.isList() ? p.listIndexSize_ : 0;
+			for(std::size_t k = 0; k < b.fields.size(); k++)
+				if(b.fields[k].property == e.order_[j])
 				{
-					fmt = format::binary;
-					endian = std::endian::little;
+					if(slot.listIndexSize || p.tid_ != b.fields[k].tid)
+						throw std::runtime_error(std::format("property \"{}\" of element \"{}\" does not match the type of its field", e.order_[j], b.name));
+					slot.field = k;
+					found[k] = true;
 				}
-				else
-					throw std::runtime_error(std::format("read line {}: invalid", lIdx));
-				if(a[2] != str::version)
-					throw std::runtime_error(std::format("read line {}: invalid version. Only 1.0 is supported", lIdx));
-			}
-			else
+		}
+		for(std::size_t k = 0; k < b.fields.size(); k++)
+			if(!found[k])
+				throw std::runtime_error(std::format("element \"{}\" has no property \"{}\"", b.name, b.fields[k].property));
+		b.rows->resize(e.size_);
+	}
+
+	template<std::endian ee, typename S>
+	void typed::decode(internal::inbuf & buf, binding<S> & b)
+	{
+		constexpr bool swapEndian = ee != std::endian::native;
+		auto bytes = [&buf, &b] (std::size_t n) {
+			auto src = buf.need(n);
+			if(!src)
+				throw std::runtime_error(std::format("unexpected end of file in element \"{}\"", b.name));
+			return src;
+		};
+		auto const size = b.rows->size();
+		auto dst = reinterpret_cast<char*>(b.rows->data());
+		bool lists = false;
+		std::size_t stride = 0;
+		for(auto & slot : b.slots_)
+		{
+			lists |= slot.listIndexSize != 0;
+			stride += slot.size;
+		}
+		if(!lists)
+		{ // rows of a fixed size are decoded block by block, field by field
+			bool bulk = !swapEndian && packed(b) && b.slots_.size() == b.fields.size();
+			for(std::size_t k = 0; bulk && k < b.slots_.size(); k++)
+				bulk = b.slots_[k].field == k;
+			std::size_t const rowsPerBlock = std::max<std::size_t>(1, (std::size_t(1) << 18) / std::max<std::size_t>(1, stride));
+			for(std::size_t i = 0; i < size; i += rowsPerBlock)
 			{
-				auto a = internal::split(line, str::space);
-				switch(line[0])
+				auto n = std::min(rowsPerBlock, size - i);
+				auto src = bytes(n * stride);
+				if(bulk) // the file rows are the memory of S
+					std::memcpy(dst + i * sizeof(S), src, n * stride);
+				else
 				{
-				case 'c':
-				{ // comment ...
-					if(a[0] != str::comment)
-						throw std::runtime_error(std::format("read line {}: invalid", lIdx));
-					comments_.push_back(line.substr(a[0].size() + 1));
-				} break;
-				case 'e':
-				{ // element name size
-					if(a[0] != str::elem)
-						throw std::runtime_error(std::format("read line {}: invalid", lIdx));
-					lastElement = &this->operator()(a[1], std::stoi(a[2]));
-				} break;
-				case 'p':
-				{ // property
-					if(a[0] != str::prop)
-						throw std::runtime_error(std::format("read line {}: invalid", lIdx));
-					if(a[1] == str::list)
-					{ // property list type type name
-						lastElement->operator()(a[4], typeidFromStr(a[3], true));
-						auto listTid = typeidFromStr(a[2], false);
-						if(listTid != typeid(std::uint8_t) && listTid != typeid(std::uint16_t) && listTid != typeid(std::uint32_t))
-							throw std::runtime_error(std::format("read line {}: invalid property list index type", lIdx));
-						lastElement->operator()(a[4]).listIndexSize_ =
-							listTid == typeid(std::uint8_t) ? 1 : listTid == typeid(std::uint16_t) ? 2 : 4;
-					}
-					else
-					{ // property type name
-						lastElement->operator()(a[2], typeidFromStr(a[1], false));
+					std::size_t offset = 0;
+					for(auto & slot : b.slots_)
+					{
+						if(slot.field != std::string::npos)
+							internal::stridedCopy(src + offset, stride, dst + i * sizeof(S) + b.fields[slot.field].offset, sizeof(S), n, slot.size, swapEndian);
+						offset += slot.size;
 					}
-				} break;
-				default:
-				{
-					// warning might be sufficient, just ignore the line?
-					throw std::runtime_error(std::format("read line {}: invalid", lIdx));
-				}
 				}
+				buf.skip(n * stride);
 			}
-			lIdx++;
+			return;
 		}
-#ifdef USE_CRLF_LFCR_HEADER_HACK
-		auto crlfa = *reinterpret_cast<std::array<std::uint16_t, 2>*>(&crlfCounter);
-		// Problem: per definition "end_header\r" is the end of the header, but many implementations also
-		// use "end_header\n" or "end_header\r\n" or any amount of \n and \r in any sequence. Why? Noone knows.
-		// we expect that there are (avgNSep - 1) seperators after "end_header" left in the stream because one of them was already consumed via getline
-		// we expect that all the seperators \n and \r are used without any other characters inbetween
-		int avgNSep = static_cast<int>(std::lround((static_cast<float>(crlfa[0]) + static_cast<float>(crlfa[1]) - 1) / lIdx));
-		// if avgNSep is no integer -> inconsistent number of linesep per line
-		for(int i = 1; i < avgNSep; i++)
+		for(std::size_t i = 0; i < size; i++)
+			for(auto & slot : b.slots_)
+			{
+				if(slot.listIndexSize)
+				{ // lists are never bound
+					auto n = internal::listIndex(bytes(slot.listIndexSize), slot.listIndexSize, swapEndian);
+					buf.skip(slot.listIndexSize);
+					bytes(n * slot.size);
+					buf.skip(n * slot.size);
+					continue;
+				}
+				auto src = bytes(slot.size);
+				if(slot.field != std::string::npos)
+					internal::stridedCopy(src, 0, dst + i * sizeof(S) + b.fields[slot.field].offset, 0, 1, slot.size, swapEndian);
+				buf.skip(slot.size);
+			}
+	}
+
+	template<typename S>
+	const char* typed::parse(const char* cur, const char* last, std::size_t i, binding<S> & b)
+	{
+		auto dst = reinterpret_cast<char*>(b.rows->data());
+		double skipped; // values that are not bound are parsed and dropped
+		for(auto & slot : b.slots_)
 		{
-			if((lastDecodedChar == str::cr || lastDecodedChar == str::lf) && (in.peek() == str::cr || in.peek() == str::lf))
-				in.get(lastDecodedChar);
+			if(slot.listIndexSize)
+			{
+				std::int64_t n = 0;
+				cur = internal::fromChars(cur, last, n);
+				if(n < 0)
+					throw std::runtime_error("Negative size for property list");
+				for(std::int64_t j = 0; j < n; j++)
+					cur = internal::fromChars(cur, last, skipped);
+			}
+			else if(slot.field != std::string::npos)
+			{
+				auto & f = b.fields[slot.field];
+				alignas(std::max_align_t) char x[8];
+				cur = f.parse(cur, last, x);
+				std::memcpy(dst + i * sizeof(S) + f.offset, x, f.size);
+			}
 			else
-				throw std::runtime_error("inconsistent line seperators in header");
+				cur = internal::fromChars(cur, last, skipped);
 		}
-#endif
-		if(fmt == format::ascii)
+		return cur;
+	}
+
+	template<typename S>
+	void typed::declare(root & header, binding<S> const & b)
+	{
+		auto & e = header(b.name, b.rows->size());
+		for(auto & f : b.fields)
+			e.declare(f.property, f.tid);
+	}
+
+	template<typename S>
+	bool typed::packed(binding<S> const & b)
+	{
+		std::size_t offset = 0;
+		for(auto & f : b.fields)
 		{
-			std::stringstream ss;
-			line.clear();
-			while(true)
-			{ // ascii can hold a lot of garbage... better sanitize it.
-				crlfCounter += internal::getline(in, line, lastDecodedChar);
-				if(!line.size()) break;
-				ss << line << linesep_;
-			}
-			for(std::size_t i = 0; i < order_.size(); i++)
+			if(f.offset != offset)
+				return false;
+			offset += f.size;
+		}
+		return offset == sizeof(S);
+	}
+
+	template<std::endian ee, typename S>
+	void typed::encode(std::ostream & out, binding<S> const & b)
+	{
+		constexpr bool swapEndian = ee != std::endian::native;
+		auto const size = b.rows->size();
+		auto src = reinterpret_cast<const char*>(b.rows->data());
+		if(!swapEndian && packed(b))
+		{ // the memory of S is the file rows
+			out.write(src, static_cast<std::streamsize>(size * sizeof(S)));
+			return;
+		}
+		std::size_t stride = 0;
+		for(auto & f : b.fields)
+			stride += f.size;
+		std::size_t const rowsPerBlock = std::max<std::size_t>(1, (std::size_t(1) << 18) / std::max<std::size_t>(1, stride));
+		std::vector<char> block(std::min(rowsPerBlock, size) * stride);
+		for(std::size_t i = 0; i < size; i += rowsPerBlock)
+		{
+			auto n = std::min(rowsPerBlock, size - i);
+			std::size_t offset = 0;
+			for(auto & f : b.fields)
 			{
-				auto & e = elements_[order_[i]];
-				e.read<format::ascii>(ss);
+				internal::stridedCopy(src + i * sizeof(S) + f.offset, sizeof(S), block.data() + offset, stride, n, f.size, swapEndian);
+				offset += f.size;
 			}
+			out.write(block.data(), static_cast<std::streamsize>(n * stride));
 		}
-		else
+	}
+
+	template<typename S>
+	void typed::print(std::ostream & out, binding<S> const & b, bool more)
+	{
+		std::size_t const blockSize = std::size_t(1) << 20;
+		std::string block;
+		block.reserve(blockSize + 256);
+		auto src = reinterpret_cast<const char*>(b.rows->data());
+		auto const size = b.rows->size();
+		for(std::size_t i = 0; i < size; i++)
 		{
-			for(std::size_t i = 0; i < order_.size(); i++)
+			for(std::size_t k = 0; k < b.fields.size(); k++)
 			{
-				auto & e = elements_[order_[i]];
-				if(endian == std::endian::little)
-					e.read<format::binary, std::endian::little>(in);
-				else
-					e.read<format::binary, std::endian::big>(in);
+				if(k)
+					block += str::space;
+				b.fields[k].print(block, src + i * sizeof(S) + b.fields[k].offset);
+			}
+			if(i < size - 1)
+				block += str::lf;
+			if(block.size() >= blockSize)
+			{
+				out.write(block.data(), static_cast<std::streamsize>(block.size()));
+				block.clear();
 			}
 		}
+		if(more)
+			block += str::lf;
+		out.write(block.data(), static_cast<std::streamsize>(block.size()));
 	}
 
-	template<format ff, std::endian ee>
-	void root::write(std::string const & path) const
+	// ---------------------------------------------------------------
+	// Writer
+	// ---------------------------------------------------------------
+
+	writer::writer(std::ostream & out, format fmt, std::endian endian) : out_(&out), fmt_(fmt), endian_(endian)
 	{
-		std::ofstream out(path, std::ios::binary | std::ios::trunc | std::ios::out);
-		if(!out.good())
+	}
+
+	writer::writer(std::string const & path, format fmt, std::endian endian) : fmt_(fmt), endian_(endian)
+	{
+		file_ = std::make_unique<std::ofstream>(path, std::ios::binary | std::ios::trunc | std::ios::out);
+		if(!file_->good())
 			throw std::runtime_error(std::format("Cannot open file in write mode \"{}\"", path));
-		write<ff, ee>(out);
+		out_ = file_.get();
 	}
 
-	std::string root::str() const
+	writer & writer::element(std::string_view name, std::size_t size)
 	{
-		std::ostringstream out;
-		write<format::ascii>(out);
-		return out.str();
+		if(started_)
+			throw std::runtime_error("elements must be declared before writing rows");
+		if(header_.has(name))
+			throw std::runtime_error(std::format("element \"{}\" is already declared", name));
+		header_(name, size);
+		return *this;
 	}
 
-	template<format ff, std::endian ee>
-	void root::write(std::ostream & out) const
+	writer & writer::property(std::string_view name, std::type_index const & tid, std::uint8_t listIndexSize)
 	{
-		out << str::ply << linesep_;
-		out << str::format << " " << internal::formatName<ff, ee>() << " " << str::version << linesep_;
-		for(auto const & c : comments_)
-			if(c.find_first_of(str::invalidSymbols) == std::string::npos) // filter all the illegal stuff
-				out << str::comment << " " << c << linesep_;
-		auto ne = order_.size();
-		for(std::size_t i = 0; i < ne; i++)
+		if(started_ || header_.order_.empty())
+			throw std::runtime_error("properties must be declared after their element and before writing rows");
+		auto & p = header_.elements_[header_.order_.back()].declare(name, tid);
+		if(header_.info_[tid]->isList())
 		{
-			auto const & e = elements_.at(order_[i]);
-			out << str::elem << " " << e.name() << " " << e.size() << linesep_;
-			for(auto const & pname : e.order_)
-			{
-				auto const & p = e.properties_.at(pname);
-				auto const & type = *ios_.at(p.tid_).get();
-				auto const & info = *info_.at(p.tid_).get();
-				out << str::prop << " ";
-				if(info.isList()) out << str::list << " " << internal::listIndexTypeName(info.listIndexTypeSize(p.data_)) << " ";
-				out << type.names()[0] << " " << p.name() << linesep_;
-			}
+			if(listIndexSize != 1 && listIndexSize != 2 && listIndexSize != 4)
+				throw std::runtime_error(std::format("Invalid list index type size: {}", listIndexSize));
+			p.listIndexSize_ = listIndexSize;
 		}
-		out << str::end_header << linesep_;
-		for(std::size_t i = 0; i < ne; i++)
+		return *this;
+	}
+
+	std::vector<std::string> & writer::comments()
+	{
+		return header_.comments();
+	}
+
+	void writer::write(elem const & rows)
+	{
+		write(&rows);
+	}
+
+	void writer::write(elem const * rows)
+	{
+		if(fmt_ == format::ascii)
+			put<format::ascii, std::endian::native>(rows);
+		else if(endian_ == std::endian::little)
+			put<format::binary, std::endian::little>(rows);
+		else
+			put<format::binary, std::endian::big>(rows);
+	}
+
+	void writer::finish()
+	{
+		write(nullptr); // header if nothing was written yet
+		next();
+		if(element_ < header_.order_.size())
+			throw std::runtime_error(std::format("element \"{}\" misses rows", header_.order_[element_]));
+		out_->flush();
+	}
+
+	void writer::next()
+	{
+		auto & order = header_.order_;
+		while(element_ < order.size() && written_ == header_.elements_[order[element_]].size_)
 		{
-			elements_.at(order_[i]).write<ff, ee>(out);
-			if constexpr(ff == format::ascii)
-				if(i < ne - 1) out << linesep_;
+			element_++;
+			written_ = 0;
 		}
 	}
 
-	namespace internal
+	template<format ff, std::endian ee>
+	void writer::put(elem const * rows)
 	{
-
-		// can be replaced by std::byteswap(x) if everyone _HAS_CXX23
-		template<std::integral T> inline constexpr T byteswap(T x)
+		if(!started_)
 		{
-			if constexpr(sizeof(T) == 1)
-				return x;
-			else if constexpr(sizeof(T) == 2)
-				return static_cast<T>((x << 8) | (x >> 8));
-			else if constexpr(sizeof(T) == 4)
-				return static_cast<T>((x << 24) | ((x << 8) & 0x00FF0000) | ((x >> 8) & 0x0000FF00) | (x >> 24));
-			else if constexpr(sizeof(T) == 8)
-				return static_cast<T>((x << 56) | ((x << 40) & 0x00FF000000000000) | ((x << 24) & 0x0000FF0000000000) | ((x << 8) & 0x000000FF00000000) | ((x >> 8) & 0x00000000FF000000) | ((x >> 24) & 0x0000000000FF0000) | ((x >> 40) & 0x000000000000FF00) | (x >> 56));
+			header_.writeHeader<ff, ee>(*out_);
+			started_ = true;
+		}
+		if(!rows || !rows->size_)
+			return;
+		next();
+		if(element_ == header_.order_.size() || rows->name() != header_.order_[element_])
+			throw std::runtime_error(std::format("rows of element \"{}\" are not expected here", rows->name()));
+		auto & e = header_.elements_[header_.order_[element_]];
+		if(written_ + rows->size_ > e.size_)
+			throw std::runtime_error(std::format("too many rows for element \"{}\"", e.name()));
+		if(rows->order_ != e.order_)
+			throw std::runtime_error(std::format("properties of element \"{}\" do not match", e.name()));
+		std::vector<std::uint8_t> lsiz(e.order_.size());
+		for(std::size_t pIdx = 0; pIdx < e.order_.size(); pIdx++)
+		{
+			auto & p = e.properties_[e.order_[pIdx]];
+			auto & q = rows->properties_.at(e.order_[pIdx]);
+			if(p.tid_ != q.tid_)
+				throw std::runtime_error(std::format("property \"{}\" of element \"{}\" has another type", p.name(), e.name()));
+			lsiz[pIdx] = p.listIndexSize_;
+			if(lsiz[pIdx] && rows->parent_->info_.at(q.tid_)->listIndexTypeSize(q.data_) > lsiz[pIdx])
+				throw std::runtime_error(std::format("property list \"{}\" of element \"{}\" does not fit its list index", p.name(), e.name()));
 		}
+		if constexpr(ff == format::ascii)
+			if(rows_)
+				*out_ << header_.linesep_;
+		rows->write<ff, ee>(*out_, lsiz);
+		written_ += rows->size_;
+		rows_ = true;
+	}
+
+	namespace internal
+	{
 		template<typename T> inline constexpr void write(std::ostream & out, T x, bool swapEndian)
 		{
 			if(swapEndian)
@@ -1088,27 +5257,56 @@ namespace okayply
 					if(!vv.size()) return;
 					auto & v = vv[i];
 					out << v.size();
-					if constexpr(std::is_same<T, float>::value)
-						for(auto & x : v) out << " " << std::format(str::f32fmt, x);
-					else if constexpr(std::is_same<T, double>::value)
-						for(auto & x : v) out << " " << std::format(str::f64fmt, x);
-					else if constexpr(sizeof(T) == 1)
-						for(auto & x : v) out << " " << static_cast<int>(x);
-					else
-						for(auto & x : v) out << " " << x;
+					char b[32];
+					for(auto & x : v)
+					{
+						out << " ";
+						out.write(b, toChars(b, x, false) - b);
+					}
 				}
 				else if constexpr(!isList)
 				{
 					auto & v = *reinterpret_cast<const std::vector<T>*>(ptr);
-					if constexpr(std::is_same<T, float>::value)
-						out << std::format(str::f32fmt, v[i]);
-					else if constexpr(std::is_same<T, double>::value)
-						out << std::format(str::f64fmt, v[i]);
-					else if constexpr(sizeof(T) == 1)
-						out << static_cast<int>(v[i]);
-					else
-						out << v[i];
+					char b[32];
+					out.write(b, toChars(b, v[i], false) - b);
+				}
+			}
+			bool chars() const override
+			{
+				return std::is_arithmetic_v<T>;
+			}
+			const char* parse(const char* first, const char* last, void* ptr, std::size_t i) const override
+			{
+				if constexpr(isList)
+				{
+					auto & v = (*reinterpret_cast<std::vector<std::vector<T>>*>(ptr))[i];
+					std::int64_t n = 0;
+					first = fromChars(first, last, n);
+					if(n < 0)
+						throw std::runtime_error("Negative size for property list");
+					v.resize(static_cast<std::size_t>(n));
+					for(auto & x : v)
+						first = fromChars(first, last, x);
+					return first;
+				}
+				else
+					return fromChars(first, last, (*reinterpret_cast<std::vector<T>*>(ptr))[i]);
+			}
+			void print(std::string & out, const void* ptr, std::size_t i, bool shortest) const override
+			{
+				char b[32];
+				if constexpr(isList)
+				{
+					auto & v = (*reinterpret_cast<const std::vector<std::vector<T>>*>(ptr))[i];
+					out.append(b, toChars(b, v.size(), false));
+					for(auto & x : v)
+					{
+						out += str::space;
+						out.append(b, toChars(b, x, shortest));
+					}
 				}
+				else
+					out.append(b, toChars(b, (*reinterpret_cast<const std::vector<T>*>(ptr))[i], shortest));
 			}
 			void binI(std::istream & in, void* ptr, std::size_t i, std::uint8_t listIndexTypeSize, bool swapEndian) const override
 			{
@@ -1133,7 +5331,10 @@ namespace okayply
 					} break;
 					default: throw std::runtime_error(std::format("Invalid list index type size: {}", listIndexTypeSize));
 					}
-					for(auto & x : v) read(in, x, swapEndian);
+					auto data = reinterpret_cast<char*>(v.data());
+					in.read(data, static_cast<std::streamsize>(v.size() * sizeof(T)));
+					if(swapEndian)
+						byteswapBlock<sizeof(T)>(data, v.size());
 				}
 				else if constexpr(!isList)
 				{
@@ -1141,6 +5342,25 @@ namespace okayply
 					read(in, v[i], swapEndian);
 				}
 			}
+			bool blockLists() const override
+			{
+				return isList;
+			}
+			void binRows(const char* src, std::size_t stride, void* ptr, std::size_t first, std::size_t n, std::size_t k, bool swapEndian) const override
+			{
+				if constexpr(isList)
+				{
+					auto & vv = *reinterpret_cast<std::vector<std::vector<T>>*>(ptr);
+					for(std::size_t i = 0; i < n; i++)
+					{
+						auto & v = vv[first + i];
+						v.resize(k);
+						std::memcpy(v.data(), src + i * stride, k * sizeof(T));
+						if(swapEndian)
+							byteswapBlock<sizeof(T)>(reinterpret_cast<char*>(v.data()), k);
+					}
+				}
+			}
 			void binO(std::ostream & out, const void* ptr, std::size_t i, std::uint8_t listIndexTypeSize, bool swapEndian) const override
 			{
 				if constexpr(isList)
@@ -1172,6 +5392,28 @@ namespace okayply
 					write(out, v[i], swapEndian);
 				}
 			}
+			bool packs() const override
+			{
+				return std::is_arithmetic_v<T>;
+			}
+			void pack(std::string & out, const void* ptr, std::size_t i, std::uint8_t listIndexTypeSize, bool swapEndian) const override
+			{
+				auto append = [&out, swapEndian] (const T* src, std::size_t n) {
+					auto at = out.size();
+					out.resize(at + n * sizeof(T));
+					stridedCopy(reinterpret_cast<const char*>(src), sizeof(T), out.data() + at, sizeof(T), n, sizeof(T), swapEndian);
+				};
+				if constexpr(isList)
+				{
+					auto & v = (*reinterpret_cast<const std::vector<std::vector<T>>*>(ptr))[i];
+					char idx[4];
+					listIndex(idx, v.size(), listIndexTypeSize, swapEndian);
+					out.append(idx, listIndexTypeSize);
+					append(v.data(), v.size());
+				}
+				else
+					append(reinterpret_cast<const std::vector<T>*>(ptr)->data() + i, 1);
+			}
 			std::vector<std::string_view> names() const override
 			{
 				if      constexpr(std::is_same<T, std::int8_t  >::value) return {str::t_char, str::t_int8};
@@ -1184,6 +5426,10 @@ namespace okayply
 				else if constexpr(std::is_same<T, double       >::value) return {str::t_double, str::t_float64};
 				else return {};
 			}
+			std::size_t binSize() const override
+			{
+				return sizeof(T);
+			}
 		};
 	}
 
@@ -1199,5 +5445,12 @@ namespace okayply
 		registerType<std::uint32_t, internal::type_x>();
 	}
 
+	root::~root()
+	{
+		for(auto & [en, e] : elements_)
+			for(auto & [pn, p] : e.properties_)
+				drop(p);
+	}
+
 }
 
@@ -0,0 +1,333 @@
+
+// okayply regression harness
+// runs a fixed corpus of generated files through read, write and a round trip (read, write,
+// read) in every format, checks that the round trip gives the same bytes and values and
+// compares the timings against a stored baseline. exits with 1 if a check fails, the baseline
+// is missing or a case is slower than the baseline by more than the threshold (and by more than
+// a millisecond, to ignore noise in tiny cases). the baseline is scaled by a calibration
+// workload, so a baseline of another machine or a busy machine still compares. needs nothing
+// but the header.
+//
+// build: g++ -std=c++20 -O2 -pthread -I. regression.cpp -o regression
+// usage: regression [--baseline path (default okayply_baseline.json)] [--update]
+//                   [--threshold fraction (default 0.15)] [--rows n (default 200000)]
+//
+// --update writes the timings of this run as the new baseline. the baseline is a flat json
+// object of case name to seconds, e.g. {"mesh/binary_little_endian/read": 0.0123}, and the
+// rows it was measured with. rows below 100000 are rejected, the cases are too short to
+// compare.
+
+#include <okayply.h>
+#include <filesystem>
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <map>
+
+namespace
+{
+	// fewer rows give cases of a few milliseconds, their noise is above any useful threshold
+	constexpr std::size_t minRows = 100000;
+
+	// fills a root with one of the corpus files, the same for every run
+	void generate(
+		okayply::root & ply,
+		std::string_view name,
+		std::size_t rows)
+	{
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<float> real(-1000.0f, 1000.0f);
+		if(name == "points")
+		{
+			auto & v = ply("vertex", rows);
+			for(auto n : {"x", "y", "z"})
+				for(auto & x : v(n).get<float>())
+					x = real(rng);
+			for(auto n : {"red", "green", "blue"})
+				for(auto & x : v(n).get<std::uint8_t>())
+					x = static_cast<std::uint8_t>(rng());
+		}
+		else if(name == "mesh")
+		{
+			auto & v = ply("vertex", rows);
+			for(auto & x : v("x").get<double>())
+				x = real(rng);
+			for(auto & x : v("flags").get<std::uint16_t>())
+				x = static_cast<std::uint16_t>(rng());
+			auto & f = ply("face", rows * 2);
+			for(auto & x : f("vertex_indices").get<std::vector<std::int32_t>>())
+			{
+				x.resize(3 + rng() % 2);
+				for(auto & i : x)
+					i = static_cast<std::int32_t>(rng() % rows);
+			}
+			for(auto & x : f("material").get<std::int8_t>())
+				x = static_cast<std::int8_t>(rng() % 100);
+		}
+		else if(name == "mixed")
+		{
+			auto & e = ply("sample", rows);
+			for(auto & x : e("a").get<std::int16_t>())
+				x = static_cast<std::int16_t>(rng());
+			for(auto & x : e("b").get<std::uint32_t>())
+				x = static_cast<std::uint32_t>(rng());
+			for(auto & x : e("c").get<std::vector<float>>())
+			{
+				x.resize(rng() % 5);
+				for(auto & y : x)
+					y = real(rng);
+			}
+			ply("tail", 3)("d").get<double>()[1] = 0.1;
+		}
+	}
+
+	// calls fn with a null pointer of the value type of a property, false for custom types
+	template<typename Fn>
+	bool visit(
+		const std::type_index& tid,
+		Fn&& fn)
+	{
+		auto is = [&tid, &fn] (auto* x) {
+			if(tid != typeid(*x))
+				return false;
+			fn(x);
+			return true;
+		};
+		return is((std::int8_t*)nullptr) || is((std::uint8_t*)nullptr)
+			|| is((std::int16_t*)nullptr) || is((std::uint16_t*)nullptr)
+			|| is((std::int32_t*)nullptr) || is((std::uint32_t*)nullptr)
+			|| is((float*)nullptr) || is((double*)nullptr);
+	}
+
+	// same elements, properties, types and values
+	bool equal(
+		okayply::root & a,
+		okayply::root & b)
+	{
+		if(a.names() != b.names())
+			return false;
+		for(auto & name : a.names())
+		{
+			auto & ea = a(name);
+			auto & eb = b(name);
+			if(ea.size() != eb.size() || ea.names() != eb.names())
+				return false;
+			for(auto & pn : ea.names())
+			{
+				auto & pa = ea(pn);
+				auto & pb = eb(pn);
+				if(pa.listType() != pb.listType())
+					return false;
+				bool same = false;
+				visit(pa.type(), [&] (auto* x) {
+					using T = std::remove_pointer_t<decltype(x)>;
+					if(pa.isList())
+						same = std::ranges::equal(pa.get<std::vector<T>>(), pb.get<std::vector<T>>());
+					else
+						same = std::ranges::equal(pa.get<T>(), pb.get<T>());
+				});
+				if(!same)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	// a fixed workload of the kind the library does (copies, number formatting). its time scales
+	// the baseline to the speed of the machine during the run.
+	void calibrate()
+	{
+		static std::vector<char> a(std::size_t(1) << 24, 1), b(a.size());
+		std::memcpy(b.data(), a.data(), a.size());
+		char text[32];
+		std::size_t length = 0;
+		for(int i = 0; i < 200000; i++)
+			length += static_cast<std::size_t>(std::to_chars(text, text + sizeof(text), i * 0.37f).ptr - text);
+		if(length == 0 || b[7] != 1)
+			throw std::runtime_error("calibration failed");
+	}
+
+	std::string bytes(
+		okayply::root & ply,
+		okayply::format fmt,
+		std::endian endian)
+	{
+		std::ostringstream out(std::ios::binary);
+		if(fmt == okayply::format::ascii)
+			ply.write<okayply::format::ascii>(out);
+		else if(endian == std::endian::little)
+			ply.write<okayply::format::binary, std::endian::little>(out);
+		else
+			ply.write<okayply::format::binary, std::endian::big>(out);
+		return out.str();
+	}
+
+	// a flat json object of names to numbers, as written by save
+	std::map<std::string, double> load(
+		const std::string& path)
+	{
+		std::map<std::string, double> values;
+		std::ifstream in(path);
+		if(!in.good())
+			return values;
+		std::string text{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+		std::size_t at = 0;
+		while((at = text.find('"', at)) != std::string::npos)
+		{
+			auto end = text.find('"', at + 1);
+			auto colon = text.find(':', end);
+			if(end == std::string::npos || colon == std::string::npos)
+				throw std::runtime_error(std::format("invalid baseline \"{}\"", path));
+			auto first = text.find_first_not_of(" \t\r\n", colon + 1);
+			double value = 0;
+			auto r = std::from_chars(text.data() + first, text.data() + text.size(), value);
+			if(r.ec != std::errc())
+				throw std::runtime_error(std::format("invalid baseline \"{}\"", path));
+			values[text.substr(at + 1, end - at - 1)] = value;
+			at = static_cast<std::size_t>(r.ptr - text.data());
+		}
+		return values;
+	}
+
+	void save(
+		const std::string& path,
+		const std::map<std::string, double>& values)
+	{
+		std::ofstream out(path, std::ios::trunc);
+		out << "{\n";
+		std::size_t i = 0;
+		for(auto & [name, value] : values)
+			out << std::format("\t\"{}\": {}{}\n", name, value, ++i < values.size() ? "," : "");
+		out << "}\n";
+		if(!out.good())
+			throw std::runtime_error(std::format("cannot write baseline \"{}\"", path));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	try {
+		std::string baselinePath = "okayply_baseline.json";
+		bool update = false;
+		double threshold = 0.15;
+		std::size_t rows = 200000;
+		for(int i = 1; i < argc; i++)
+		{
+			std::string_view arg = argv[i];
+			if(arg == "--update")
+				update = true;
+			else if(arg == "--baseline" && i + 1 < argc)
+				baselinePath = argv[++i];
+			else if(arg == "--threshold" && i + 1 < argc)
+				threshold = std::stod(argv[++i]);
+			else if(arg == "--rows" && i + 1 < argc)
+				rows = std::stoull(argv[++i]);
+			else
+				throw std::runtime_error(std::format("unknown argument \"{}\"", arg));
+		}
+		if(rows < minRows)
+			throw std::runtime_error(std::format("--rows {} is below {}, too noisy to compare", rows, minRows));
+
+		auto baseline = load(baselinePath);
+		if(!update && baseline.empty())
+			throw std::runtime_error(std::format("no baseline at \"{}\", run with --update to create one", baselinePath));
+		if(!update && baseline["rows"] != static_cast<double>(rows))
+			throw std::runtime_error(std::format("the baseline was measured with --rows {}", baseline["rows"]));
+		std::map<std::string, double> timings;
+		bool failed = false;
+		struct target
+		{
+			okayply::format fmt;
+			std::endian endian;
+			std::string_view name;
+		};
+		target const targets[] = {
+			{okayply::format::ascii, std::endian::native, okayply::str::ascii},
+			{okayply::format::binary, std::endian::little, okayply::str::binary_little_endian},
+			{okayply::format::binary, std::endian::big, okayply::str::binary_big_endian}};
+
+		std::vector<std::pair<std::string, std::function<void()>>> cases{{"calibration", calibrate}};
+		std::vector<std::unique_ptr<okayply::root>> loaded; // written by the write cases
+		std::vector<std::string> paths;
+		for(auto corpus : {"points", "mesh", "mixed"})
+		{
+			okayply::root source;
+			generate(source, corpus, rows);
+			for(auto & t : targets)
+			{
+				auto file = bytes(source, t.fmt, t.endian);
+				auto path = (std::filesystem::temp_directory_path() / std::format("okayply_regression_{}_{}.ply", corpus, t.name)).string();
+				std::ofstream(path, std::ios::binary | std::ios::trunc).write(file.data(), static_cast<std::streamsize>(file.size()));
+				paths.push_back(path);
+
+				// the round trip gives the same bytes and values
+				auto & first = *loaded.emplace_back(std::make_unique<okayply::root>());
+				okayply::root second;
+				first.read(path);
+				auto again = bytes(first, t.fmt, t.endian);
+				std::istringstream in(again, std::ios::binary);
+				second.read(in);
+				if(again != file || !equal(source, first) || !equal(first, second))
+				{
+					std::cout << std::format("FAIL {}/{}: round trip changed the file\n", corpus, t.name);
+					failed = true;
+				}
+
+				auto prefix = std::format("{}/{}/", corpus, t.name);
+				cases.emplace_back(prefix + "read", [path] { okayply::root r; r.read(path); });
+				cases.emplace_back(prefix + "write", [&first, t] { bytes(first, t.fmt, t.endian); });
+				cases.emplace_back(prefix + "roundtrip", [path, t] {
+					okayply::root r, s;
+					r.read(path);
+					std::istringstream back(bytes(r, t.fmt, t.endian), std::ios::binary);
+					s.read(back);
+				});
+			}
+		}
+
+		// the best of a few rounds over all cases, so a slow phase of the machine hits all of them
+		for(int round = 0; round < 7; round++)
+			for(auto & [name, run] : cases)
+			{
+				auto start = std::chrono::steady_clock::now();
+				run();
+				auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				auto [it, inserted] = timings.try_emplace(name, seconds);
+				it->second = std::min(it->second, seconds);
+			}
+		for(auto & path : paths)
+			std::filesystem::remove(path);
+
+		// timings relative to the calibration of the baseline
+		double scale = baseline.contains("calibration") ? timings["calibration"] / baseline["calibration"] : 1.0;
+		if(!update && !baseline.empty())
+			std::cout << std::format("machine speed factor {:.3f}\n", scale);
+		for(auto & [name, seconds] : timings)
+		{
+			auto it = baseline.find(name);
+			if(it == baseline.end() || update || name == "calibration" || name == "rows")
+			{
+				std::cout << std::format("{:<44}{:>12.6f}\n", name, seconds);
+				continue;
+			}
+			auto expected = it->second * scale;
+			auto change = seconds / expected - 1;
+			bool slower = change > threshold && seconds - expected > 0.001;
+			failed |= slower;
+			std::cout << std::format("{:<44}{:>12.6f}{:>12.6f}{:>+9.1f}%{}\n", name, seconds, expected, change * 100, slower ? "  REGRESSION" : "");
+		}
+		if(update)
+		{
+			timings["rows"] = static_cast<double>(rows);
+			save(baselinePath, timings);
+			std::cout << std::format("baseline written to \"{}\"\n", baselinePath);
+		}
+		std::cout << (failed ? "FAILED\n" : "PASSED\n");
+		return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+	catch (std::exception& e) {
+		std::cout << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+}